@@ -0,0 +1,61 @@
+#include <fstream>
+#include <iostream>
+
+#include <cxxopts/cxxopts.hpp>
+
+#include "epuzzle/PuzzleParser.h"
+#include "epuzzle/SolverCompiler.h"
+#include "version.h"
+
+// Ahead-of-time puzzle compiler: generates the C++ source of a standalone solver of one puzzle (see epuzzle::generateSolverSource)
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const auto description = std::string("epuzzle-compile - ahead-of-time puzzle compiler, version ") + epuzzle::Version::projectVer + "\n"
+            + "Generates C++ source of a standalone solver specialized for the puzzle (up to 8 persons).";
+
+        cxxopts::Options optsManager("epuzzle-compile", description);
+        optsManager.custom_help("--file <FILE> [--output <CPP_FILE>]");
+        optsManager.add_options()
+            ("f,file", "[required] Path to puzzle definition file", cxxopts::value<std::string>())
+            ("o,output", "[optional] Path to the generated C++ file, stdout by default", cxxopts::value<std::string>())
+            ("h,help", "Print usage");
+
+        const auto parsedOpts = optsManager.parse(argc, argv);
+        if (parsedOpts.contains("help") || !parsedOpts.contains("file"))
+        {
+            std::cout << optsManager.help() << "\n";
+            std::cout << "Example: \n";
+            std::cout << "epuzzle-compile -f puzzle_examples/einsteins.toml -o einsteins.cpp && c++ -std=c++20 -O2 einsteins.cpp -o einsteins\n";
+            return EXIT_SUCCESS;
+        }
+
+        auto puzzleDefinition = epuzzle::parseFile(parsedOpts["file"].as<std::string>());
+        if (!parsedOpts.contains("output"))
+        {
+            epuzzle::generateSolverSource(std::move(puzzleDefinition), std::cout);
+            return EXIT_SUCCESS;
+        }
+
+        const auto outputPath = parsedOpts["output"].as<std::string>();
+        std::ofstream output{ outputPath };
+        if (!output)
+            throw std::runtime_error("Can't open output file: " + outputPath);
+        epuzzle::generateSolverSource(std::move(puzzleDefinition), output);
+        output.close();
+        if (!output)
+            throw std::runtime_error("Can't write output file: " + outputPath);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "\nException occured! " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    catch (...)
+    {
+        std::cerr << "\nUnknown exception occured!\n\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
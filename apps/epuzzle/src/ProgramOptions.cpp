@@ -1,3 +1,4 @@
+#include <charconv>
 #include <format>
 #include <ranges>
 #include <string_view>
@@ -47,40 +48,107 @@ namespace
         }
     };
 
-    enum class PrefilterMode : std::uint8_t
+    enum class FeatureMode : std::uint8_t
     {
         Enabled,
         Disabled
     };
 
     constexpr auto appName = epuzzle::Version::projectName;
+
+    // "i/N", i is 1-based
+    epuzzle::Solver::SolveOptions::Shard parseShard(const std::string& str)
+    {
+        size_t index = 0;
+        size_t count = 0;
+        const auto slash = str.find('/');
+        if (slash != std::string::npos)
+        {
+            const auto indexEnd = str.data() + slash;
+            const auto countEnd = str.data() + str.size();
+            const auto [indexPtr, indexErr] = std::from_chars(str.data(), indexEnd, index);
+            const auto [countPtr, countErr] = std::from_chars(indexEnd + 1, countEnd, count);
+            if (indexErr == std::errc{} && countErr == std::errc{} && indexPtr == indexEnd && countPtr == countEnd
+                && index >= 1 && index <= count)
+            {
+                return { .index = index - 1, .count = count };
+            }
+        }
+        throw std::runtime_error(std::format("Unexpected shard: {}, expected i/N where 1 <= i <= N", str));
+    }
 } // namespace
 
     std::optional<ProgramOptions> getProgramOptions(int argc, char* argv[]) 
     {
         using Method = epuzzle::SolverConfig::SolvingMethod;
         using ExecPolicy = epuzzle::SolverConfig::BruteForceConfig::ExecPolicy;
+        using WheelOrder = epuzzle::SolverConfig::BruteForceConfig::WheelOrder;
         // Note: cxxopts doesnt like string_view
         const std::string defaultMethod{ EnumHelper::name(Method::BruteForce) };
-        const std::string defaultBfPrefilter{ EnumHelper::name(PrefilterMode::Enabled) };
+        const std::string defaultEnabled{ EnumHelper::name(FeatureMode::Enabled) };
+        const std::string defaultDisabled{ EnumHelper::name(FeatureMode::Disabled) };
         const std::string defaultBfExec{ EnumHelper::name(ExecPolicy::Parallel) };
+        const std::string defaultWheelOrder{ EnumHelper::name(WheelOrder::Lexicographic) };
         const auto description = std::string(appName) + " - Logic puzzle solver, version " + epuzzle::Version::projectVer + "\n"
             + "Solves Einstein's/Zebra Puzzle and similar constraint satisfaction puzzles.";
 
         cxxopts::Options optsManager(appName, description);
         optsManager.custom_help("--file <FILE> [OPTIONS]");
         optsManager.add_options()
-            ("f,file", "[required] Path to puzzle definition file", cxxopts::value<std::string>())
+            ("f,file", "[required] Path to puzzle definition file (or compiled by the compile subcommand)", cxxopts::value<std::string>())
             ("m,method", "[optional] Solving method, where arg is: " + EnumHelper::names<Method>(),
                 cxxopts::value<std::string>()->default_value(defaultMethod))
-            ("p,prefilter", "[BruteForce only] Prefilter mode, where arg is: " + EnumHelper::names<PrefilterMode>(),
-                cxxopts::value<std::string>()->default_value(defaultBfPrefilter))
+            ("p,prefilter", "[BruteForce, RelationalJoin] Prefilter mode, where arg is: " + EnumHelper::names<FeatureMode>(),
+                cxxopts::value<std::string>()->default_value(defaultEnabled))
+            ("r,presolve", "[BruteForce, RelationalJoin] Deductive presolve mode (shrinks the search space), where arg is: " + EnumHelper::names<FeatureMode>(),
+                cxxopts::value<std::string>()->default_value(defaultEnabled))
+            ("d,decompose", "[BruteForce only] Independent sub-puzzles decomposition mode, where arg is: " + EnumHelper::names<FeatureMode>(),
+                cxxopts::value<std::string>()->default_value(defaultEnabled))
+            ("y,symmetry", "[BruteForce, RelationalJoin] Interchangeable values symmetry breaking mode, where arg is: " + EnumHelper::names<FeatureMode>(),
+                cxxopts::value<std::string>()->default_value(defaultEnabled))
+            ("mitm", "[BruteForce only] Meet-in-the-middle mode (for puzzles with many attributes), where arg is: " + EnumHelper::names<FeatureMode>(),
+                cxxopts::value<std::string>()->default_value(defaultDisabled))
+            ("pivot", "[BruteForce, RelationalJoin] Pivot axis mode (an attribute replaces persons as the fixed axis), where arg is: " + EnumHelper::names<FeatureMode>(),
+                cxxopts::value<std::string>()->default_value(defaultEnabled))
+            ("probing", "[optional] Failed-literal probing presolve mode, where arg is: " + EnumHelper::names<FeatureMode>(),
+                cxxopts::value<std::string>()->default_value(defaultDisabled))
             ("e,execpolicy", "[BruteForce only] Execution policy, where arg is: " + EnumHelper::names<ExecPolicy>(),
                 cxxopts::value<std::string>()->default_value(defaultBfExec))
+            ("w,wheelorder", "[BruteForce only] Order of permutations on the wheels, where arg is: " + EnumHelper::names<WheelOrder>(),
+                cxxopts::value<std::string>()->default_value(defaultWheelOrder))
+            ("s,seed", "[LocalSearch only] Random seed, the same seed repeats the same search",
+                cxxopts::value<std::uint64_t>()->default_value("1"))
+            ("t,timebudget", "[LocalSearch only] Time budget in seconds",
+                cxxopts::value<std::uint32_t>()->default_value("10"))
+            ("c,count", "[optional] Print solutions count only. Counting method counts without enumeration of solutions")
+            ("checkpoint", "[Parallel BruteForce] Save the search progress to the file every minute and on Ctrl+C (SIGINT, SIGTERM)",
+                cxxopts::value<std::string>())
+            ("resume", "[Parallel BruteForce] Continue the search saved in the --checkpoint file")
+            ("shard", "[Parallel BruteForce] Search the slice i of N of the search space only (i/N, 1-based), the --checkpoint file is the result. "
+                "Merge the results of all shards: " + std::string(appName) + " merge [OPTIONS] --checkpoint <MERGED FILE> <SHARD FILES>",
+                cxxopts::value<std::string>())
+            ("shards", "Shard result files of the merge subcommand", cxxopts::value<std::vector<std::string>>())
+            ("o,output", "[compile] Path to the compiled puzzle file: " + std::string(appName) + " compile [OPTIONS] --file <FILE> --output <COMPILED FILE>. "
+                "The compiled file is loaded by --file, solving with the same options skips parsing and preparation",
+                cxxopts::value<std::string>())
+            ("wheels", "[compile, BruteForce, RelationalJoin] Save the prebuilt wheels to the compiled puzzle file, where arg is: " + EnumHelper::names<FeatureMode>(),
+                cxxopts::value<std::string>()->default_value(defaultEnabled))
+            ("cache", "[BruteForce, Counting, RelationalJoin] Result cache directory: a puzzle solved before (up to the labels and the order) "
+                "is not solved again", cxxopts::value<std::string>())
             ("v,version", "Print version")
             ("h,help", "Print usage");
 
-        const auto parsedOpts = optsManager.parse(argc, argv);
+        optsManager.parse_positional({ "shards" });
+
+        // `merge` subcommand: the same options as the sharded run, followed by the shard result files.
+        // `compile` subcommand: the solver options the compiled puzzle is prepared for, and --output
+        std::vector<char*> args(argv, argv + argc);
+        const std::string_view subcommand = (args.size() > 1) ? args[1] : "";
+        const bool merge = subcommand == "merge";
+        const bool compile = subcommand == "compile";
+        if (merge || compile)
+            args.erase(std::next(args.begin()));
+        const auto parsedOpts = optsManager.parse(static_cast<int>(args.size()), args.data());
         if (parsedOpts.contains("help") || parsedOpts.arguments().empty())
         {
             std::cout << optsManager.help() << "\n";
@@ -97,11 +165,39 @@ namespace
                 << " --method " << EnumHelper::name(Method::BruteForce)
                 << " --execpolicy " << EnumHelper::name(ExecPolicy::Parallel) << "\n\n";
 
-            std::cout << "# Disable prefilter for Sequential BruteForce\n";
+            std::cout << "# Disable prefilter and presolve for Sequential BruteForce\n";
             std::cout << appName << " -f test.toml"
                 << " -m " << EnumHelper::name(Method::BruteForce)
-                << " -p " << EnumHelper::name(PrefilterMode::Disabled)
-                << " -e " << EnumHelper::name(ExecPolicy::Sequential);
+                << " -p " << EnumHelper::name(FeatureMode::Disabled)
+                << " -r " << EnumHelper::name(FeatureMode::Disabled)
+                << " -e " << EnumHelper::name(ExecPolicy::Sequential) << "\n\n";
+
+            std::cout << "# Count solutions of an underconstrained puzzle without enumeration\n";
+            std::cout << appName << " -f four_girls.toml"
+                << " -m " << EnumHelper::name(Method::Counting) << " --count\n\n";
+
+            std::cout << "# Join wheels as relations instead of the full enumeration (for puzzles with many attributes)\n";
+            std::cout << appName << " -f big.toml"
+                << " -m " << EnumHelper::name(Method::RelationalJoin) << "\n\n";
+
+            std::cout << "# Long search: save the progress, after an interruption continue it\n";
+            std::cout << appName << " -f big.toml --checkpoint big.checkpoint --resume\n\n";
+
+            std::cout << "# One search on 20 hosts: the shard 7 of 20, after all the shards are done merge the results\n";
+            std::cout << appName << " -f big.toml --shard 7/20 --checkpoint big.shard7\n";
+            std::cout << appName << " merge -f big.toml --checkpoint big.merged big.shard1 big.shard2 ... big.shard20\n\n";
+
+            std::cout << "# Regression corpus: compile each puzzle once (the model and the wheels), then solve it without preparation\n";
+            std::cout << appName << " compile -f zebra.toml -o zebra.epz\n";
+            std::cout << appName << " -f zebra.epz\n\n";
+
+            std::cout << "# Batch of puzzles: the ones solved before (maybe with other labels) are answered from the result cache\n";
+            std::cout << appName << " -f zebra.toml --cache results/\n\n";
+
+            std::cout << "# Find one solution of a huge puzzle by LocalSearch within 60 seconds\n";
+            std::cout << appName << " -f huge.toml"
+                << " -m " << EnumHelper::name(Method::LocalSearch)
+                << " -t 60 -s 42";
 
             std::cout << "\n";
             return {};
@@ -115,14 +211,60 @@ namespace
 
         ProgramOptions programOpts;
         programOpts.config.solvingMethod = EnumHelper::cast<Method>(parsedOpts["method"].as<std::string>());
-        if (programOpts.config.solvingMethod == Method::BruteForce)
+        if (programOpts.config.solvingMethod == Method::BruteForce || programOpts.config.solvingMethod == Method::RelationalJoin)
         {
             programOpts.config.bruteForce =
             {
-                .prefilter = (PrefilterMode::Enabled == EnumHelper::cast<PrefilterMode>(parsedOpts["prefilter"].as<std::string>())),
-                .execution = EnumHelper::cast<ExecPolicy>(parsedOpts["execpolicy"].as<std::string>())
+                .prefilter = (FeatureMode::Enabled == EnumHelper::cast<FeatureMode>(parsedOpts["prefilter"].as<std::string>())),
+                .presolve = (FeatureMode::Enabled == EnumHelper::cast<FeatureMode>(parsedOpts["presolve"].as<std::string>())),
+                .decompose = (FeatureMode::Enabled == EnumHelper::cast<FeatureMode>(parsedOpts["decompose"].as<std::string>())),
+                .breakSymmetry = (FeatureMode::Enabled == EnumHelper::cast<FeatureMode>(parsedOpts["symmetry"].as<std::string>())),
+                .meetInTheMiddle = (FeatureMode::Enabled == EnumHelper::cast<FeatureMode>(parsedOpts["mitm"].as<std::string>())),
+                .pivot = (FeatureMode::Enabled == EnumHelper::cast<FeatureMode>(parsedOpts["pivot"].as<std::string>())),
+                .execution = EnumHelper::cast<ExecPolicy>(parsedOpts["execpolicy"].as<std::string>()),
+                .wheelOrder = EnumHelper::cast<WheelOrder>(parsedOpts["wheelorder"].as<std::string>())
+            };
+        }
+        else if (programOpts.config.solvingMethod == Method::LocalSearch)
+        {
+            programOpts.config.localSearch =
+            {
+                .seed = parsedOpts["seed"].as<std::uint64_t>(),
+                .timeBudget = std::chrono::seconds(parsedOpts["timebudget"].as<std::uint32_t>())
             };
         }
+        programOpts.config.probing = (FeatureMode::Enabled == EnumHelper::cast<FeatureMode>(parsedOpts["probing"].as<std::string>()));
+        programOpts.countOnly = parsedOpts.contains("count");
+        if (parsedOpts.contains("checkpoint"))
+            programOpts.checkpointFile = parsedOpts["checkpoint"].as<std::string>();
+        programOpts.resume = parsedOpts.contains("resume");
+        if (parsedOpts.contains("shard"))
+            programOpts.shard = parseShard(parsedOpts["shard"].as<std::string>());
+        if (parsedOpts.contains("shards"))
+        {
+            if (!merge)
+                throw std::runtime_error("Unexpected arguments (shard result files are expected by the merge subcommand only)");
+            programOpts.mergeShards = parsedOpts["shards"].as<std::vector<std::string>>();
+        }
+        if (merge)
+        {
+            if (programOpts.mergeShards.empty() || programOpts.shard)
+                throw std::runtime_error("merge expects the shard result files (and no --shard)");
+            programOpts.resume = true; // all the solutions are in the merged file
+        }
+        if (parsedOpts.contains("output"))
+        {
+            if (!compile)
+                throw std::runtime_error("--output is expected by the compile subcommand only");
+            programOpts.compiledFilePath = parsedOpts["output"].as<std::string>();
+        }
+        if (compile && programOpts.compiledFilePath.empty())
+            throw std::runtime_error("compile requires --output <COMPILED FILE>");
+        programOpts.compileWheels = (FeatureMode::Enabled == EnumHelper::cast<FeatureMode>(parsedOpts["wheels"].as<std::string>()));
+        if (parsedOpts.contains("cache"))
+            programOpts.resultCacheDir = parsedOpts["cache"].as<std::string>();
+        if ((programOpts.resume || programOpts.shard) && programOpts.checkpointFile.empty())
+            throw std::runtime_error("--resume, --shard and merge require --checkpoint <FILE>");
         programOpts.puzzleFilePath = parsedOpts["file"].as<std::string>();
         return programOpts;
     }
@@ -3,7 +3,9 @@
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "epuzzle/Solver.h"
 #include "epuzzle/SolverConfig.h"
 #include "version.h"
 
@@ -14,6 +16,14 @@ namespace cli
     {
         epuzzle::SolverConfig config;
         std::string puzzleFilePath;
+        bool countOnly = false; // print solutions count only (without solutions)
+        std::string checkpointFile; // empty - no checkpoints
+        bool resume = false; // continue the search saved in the checkpoint file
+        std::optional<epuzzle::Solver::SolveOptions::Shard> shard; // search this slice of the search space only
+        std::vector<std::string> mergeShards; // `merge` subcommand: the shard result files merged into the checkpoint file
+        std::string compiledFilePath; // `compile` subcommand: the compiled puzzle file written (see epuzzle::CompiledPuzzle)
+        bool compileWheels = true; // the compiled puzzle file keeps the prebuilt wheels
+        std::string resultCacheDir; // empty - no result cache (see epuzzle::ResultCache)
     };
 
     std::optional<ProgramOptions> getProgramOptions(int argc, char* argv[]); // throw std::runtime_error
@@ -1,15 +1,62 @@
+#include <atomic>
+#include <csignal>
 #include <ranges>
 
 #include "utils/Diagnostics.h"
 #include "utils/Math.h"
 #include "utils/platform/ConsoleUtils.h"
 
+#include "epuzzle/CompiledPuzzle.h"
 #include "epuzzle/Exceptions.h"
 #include "epuzzle/PuzzleParser.h"
+#include "epuzzle/ResultCache.h"
 #include "epuzzle/Solver.h"
 
 #include "ProgramOptions.h"
 
+namespace
+{
+    // Set by SIGINT/SIGTERM: the search is canceled gracefully, so the checkpoint gets the last finished ranges
+    std::atomic<int> g_stopSignal{ 0 };
+    static_assert(std::atomic<int>::is_always_lock_free); // safe in a signal handler
+
+    extern "C" void onStopSignal(int signal)
+    {
+        g_stopSignal.store(signal, std::memory_order_relaxed);
+    }
+
+    void printSolutions(const epuzzle::SolutionSet& solutions)
+    {
+        using namespace utils;
+        std::cout << "Solutions found: " << solutions.size() << "\n";
+        if (solutions.multiplicity() == 1)
+        {
+            for (auto solNum : std::views::iota(0_u64, solutions.size()))
+            {
+                std::cout << "Solution #" << solNum + 1 << ":\n";
+                std::cout << solutions[solNum] << "\n";
+            }
+        }
+        else
+        {
+            // Print symmetry classes only: the other solutions differ by permutations of interchangeable values
+            std::cout << "Interchangeable values (any permutation of their owners gives a solution):\n";
+            for (const auto& group : solutions.symmetry())
+            {
+                std::cout << "  " << group.type << ":";
+                for (const auto& value : group.values)
+                    std::cout << " " << value;
+                std::cout << "\n";
+            }
+            for (auto classNum : std::views::iota(0_u64, solutions.classCount()))
+            {
+                std::cout << "Solution class #" << classNum + 1 << " (" << solutions.multiplicity() << " solutions):\n";
+                std::cout << solutions.representative(classNum) << "\n";
+            }
+        }
+    }
+}
+
 int main(int argc, char* argv[])
 {
     int retcode = EXIT_SUCCESS;
@@ -24,27 +71,94 @@ int main(int argc, char* argv[])
 
         cli::printVersion();
         std::cout << "Config: " << options->config << "\n";
-        auto puzzleDefinition = epuzzle::parseFile(options->puzzleFilePath);
-        std::cout << "Puzzle loaded: \n" << puzzleDefinition << "\n";
+        // A compiled puzzle is not parsed; solved with the options it is compiled with, it is not prepared either
+        std::optional<epuzzle::CompiledPuzzle> compiledPuzzle;
+        epuzzle::PuzzleDefinition puzzleDefinition;
+        if (epuzzle::CompiledPuzzle::isCompiledPuzzle(options->puzzleFilePath))
+            compiledPuzzle = epuzzle::CompiledPuzzle::load(options->puzzleFilePath);
+        else
+            puzzleDefinition = epuzzle::parseFile(options->puzzleFilePath);
+        std::cout << "Puzzle loaded: \n" << (compiledPuzzle ? compiledPuzzle->definition() : puzzleDefinition) << "\n";
+        if (!options->compiledFilePath.empty())
+        {
+            epuzzle::compilePuzzle(options->config, compiledPuzzle ? compiledPuzzle->definition() : std::move(puzzleDefinition),
+                options->compiledFilePath, options->compileWheels);
+            std::cout << "Puzzle compiled: " << options->compiledFilePath << "\n";
+            std::cout << "Elapsed: " << sw.elapsed() << "\n";
+            return EXIT_SUCCESS;
+        }
         std::cout << "Preparing ... \n";
-        auto solver = epuzzle::Solver::create(options->config, std::move(puzzleDefinition));
+        if (!options->mergeShards.empty())
+        {
+            epuzzle::mergeShards({ options->mergeShards.begin(), options->mergeShards.end() }, options->checkpointFile);
+            std::cout << "Shards merged: " << options->mergeShards.size() << " files into " << options->checkpointFile << "\n";
+        }
+        // The result cache is of puzzle definitions: a compiled puzzle is solved with its prebuilt wheels instead
+        std::optional<epuzzle::ResultCache> resultCache;
+        if (!options->resultCacheDir.empty() && !compiledPuzzle)
+            resultCache.emplace(options->resultCacheDir);
+        auto solver = compiledPuzzle ? epuzzle::Solver::create(options->config, *compiledPuzzle)
+            : resultCache ? epuzzle::Solver::create(options->config, std::move(puzzleDefinition), *resultCache)
+            : epuzzle::Solver::create(options->config, std::move(puzzleDefinition));
         std::cout << "Preparing done.\n";
+        for (const auto& [name, value] : solver->statistics())
+            std::cout << "  " << name << ": " << value << "\n";
 
         using namespace utils;
         using namespace std::chrono_literals;
-        auto solutions = solver->solve({ .progressInterval = 900ms, .progressCallback = [](std::uint64_t total, std::uint64_t current)
+        const epuzzle::Solver::SolveOptions solveOptions{ .progressInterval = 900ms, .progressCallback = [](std::uint64_t total, std::uint64_t current)
             {
                 const double percents = static_cast<double>(current) / static_cast<double>(std::max(1_u64, total)) * 100.0;
                 std::cout << "\rSolving ...  " << std::fixed << std::setprecision(3) << percents << " %   " << std::flush;
-                return true; // you can return false in GUI version if user pressed "cancel" button
-            } });
+                return g_stopSignal.load(std::memory_order_relaxed) == 0; // you can return false in GUI version if user pressed "cancel" button
+            },
+            .checkpointFile = options->checkpointFile, .resume = options->resume, .shard = options->shard };
+        if (!options->checkpointFile.empty())
+        {
+            std::signal(SIGINT, onStopSignal);
+            std::signal(SIGTERM, onStopSignal);
+        }
 
-        std::cout << "\nSolving finished!\n";
-        std::cout << "Solutions found: " << solutions.size() << "\n";
-        for (auto solNum : std::views::iota(0ul, solutions.size()))
+        // Interrupted: the partial results are not printed, the checkpoint keeps them
+        auto interrupted = [&options]
+            {
+                if (g_stopSignal.load(std::memory_order_relaxed) == 0)
+                    return false;
+                std::cout << "\nSolving interrupted! The progress is saved to the checkpoint: " << options->checkpointFile
+                    << ", continue with --resume\n";
+                return true;
+            };
+        // Sharded: the solutions of the slice are not printed, the shard result (checkpoint) file keeps them until merged
+        auto shardFinished = [&options]
+            {
+                if (!options->shard)
+                    return false;
+                std::cout << "\nShard " << options->shard->index + 1 << "/" << options->shard->count << " finished! The result is saved to "
+                    << options->checkpointFile << ", merge the results of all shards by the merge subcommand\n";
+                return true;
+            };
+
+        if (options->countOnly)
         {
-            std::cout << "Solution #" << solNum + 1 << ":\n";
-            std::cout << solutions[solNum] << "\n";
+            const auto count = solver->countSolutions(solveOptions);
+            if (interrupted())
+                retcode = EXIT_FAILURE;
+            else if (!shardFinished())
+            {
+                std::cout << "\nSolving finished!\n";
+                std::cout << "Solutions count: " << count << "\n";
+            }
+        }
+        else
+        {
+            const auto solutions = solver->solveSet(solveOptions); // combined lazily on access
+            if (interrupted())
+                retcode = EXIT_FAILURE;
+            else if (!shardFinished())
+            {
+                std::cout << "\nSolving finished!\n";
+                printSolutions(solutions);
+            }
         }
     }
     catch (const std::exception& e)
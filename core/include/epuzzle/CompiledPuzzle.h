@@ -0,0 +1,43 @@
+#pragma once
+#include <filesystem>
+#include <memory>
+
+#include "PuzzleDefinition.h"
+#include "SolverConfig.h"
+
+namespace epuzzle
+{
+
+    // Precompiled puzzle: a versioned binary file with the puzzle model as Solver::create prepares it for some config (normalized,
+    // validated, indexed: interned names, constraints by ids, probed facts) and, optionally, the prefiltered bruteforce wheels.
+    // Solver::create of it with the same config skips parsing and the preparation; with another config it starts from the definition.
+    class CompiledPuzzle
+    {
+    public:
+        // The file is memory-mapped while loading. Throw PuzzleSyntaxError if it is not a compiled puzzle, of another version or corrupted.
+        static CompiledPuzzle load(const std::filesystem::path&);
+        static bool isCompiledPuzzle(const std::filesystem::path&); // by the file signature
+
+        ~CompiledPuzzle();
+        CompiledPuzzle(CompiledPuzzle&&) noexcept;
+        CompiledPuzzle& operator=(CompiledPuzzle&&) noexcept;
+
+        const PuzzleDefinition& definition() const; // normalized
+        bool compiledWith(const SolverConfig&) const;
+        bool hasWheels() const;
+
+        struct Data; // internal
+        const Data& data() const { return *m_data; }
+
+    private:
+        explicit CompiledPuzzle(std::unique_ptr<Data>);
+
+    private:
+        std::unique_ptr<Data> m_data;
+    };
+
+    // Write the compiled puzzle file (see CompiledPuzzle). withWheels - for BruteForce and RelationalJoin: the wheels of all the solver
+    // contexts (of the pivoted model, of the decomposed parts) are generated and saved too. Throw as Solver::create.
+    void compilePuzzle(SolverConfig, PuzzleDefinition, const std::filesystem::path&, bool withWheels = true);
+
+}
@@ -0,0 +1,212 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <variant>
+
+#include "Exceptions.h"
+#include "PuzzleDefinition.h"
+
+namespace epuzzle
+{
+    // Constexpr solving core for small puzzles: fixed capacity containers, no virtuals, no heap during the search.
+    // Usable in consteval contexts: static_assert of solution counts, solution tables embedded at compile time.
+    // Exhaustive backtracking over the attribute types, each constraint is checked as soon as its types are assigned.
+    // Throw (compile error in a constant expression) on invalid names or on capacity overflow.
+    namespace ct
+    {
+        constexpr size_t maxPersons = 6;
+        constexpr size_t maxAttrTypes = 6;
+        constexpr size_t maxConstraints = 32;
+
+        // Owner person of each value of each attribute type (indexes in the PuzzleDefinition order)
+        struct Solution
+        {
+            std::array<std::array<std::uint8_t, maxPersons>, maxAttrTypes> owners{};
+        };
+
+        // The first min(count, Capacity) solutions, in the search order
+        template <size_t Capacity>
+        struct Solutions
+        {
+            std::uint64_t count = 0;
+            std::array<Solution, Capacity> solutions{};
+        };
+
+    namespace details
+    {
+        // Semantics of the position comparison: pos1 (of the first) relation pos2 (of the second).
+        // Internal, shared by all engines (see also bruteforce CheckerImpl), so they always agree.
+        constexpr bool relationHolds(PuzzleDefinition::Comparison::Relation relation, std::ptrdiff_t pos1, std::ptrdiff_t pos2)
+        {
+            using Relation = PuzzleDefinition::Comparison::Relation;
+            switch (relation)
+            {
+            case Relation::ImmediateLeft:   return pos2 - pos1 == 1;
+            case Relation::ImmediateRight:  return pos1 - pos2 == 1;
+            case Relation::Adjacent:        return pos1 - pos2 == 1 || pos2 - pos1 == 1;
+            case Relation::Before:          return pos1 < pos2;
+            case Relation::After:           return pos1 > pos2;
+            default: throw PuzzleLogicError("Unexpected PuzzleDefinition::Comparison::relation");
+            };
+        }
+
+        // Person (by name or as the owner of a value): type == attrTypeCount for the person itself
+        struct Ref
+        {
+            size_t type = 0;
+            size_t index = 0; // person or value
+        };
+
+        struct Constraint
+        {
+            Ref first;
+            Ref second;
+            bool negate = false; // Fact: the second is not the first
+            bool isComparison = false;
+            size_t compareBy = 0;
+            PuzzleDefinition::Comparison::Relation relation = PuzzleDefinition::Comparison::Relation::Uninitialized;
+            size_t lastType = 0; // checked when this type is assigned
+        };
+
+        struct Model
+        {
+            size_t personCount = 0;
+            size_t attrTypeCount = 0;
+            std::array<Constraint, maxConstraints> constraints{};
+            size_t constraintCount = 0;
+        };
+
+        template <typename TRange, typename TValue>
+        constexpr size_t indexOf(const TRange& range, const TValue& value)
+        {
+            const auto found = std::find(range.begin(), range.end(), value);
+            if (found == range.end())
+                throw PuzzleLogicError("Unexpected name in the puzzle definition");
+            return static_cast<size_t>(found - range.begin());
+        }
+
+        constexpr Model makeModel(const PuzzleDefinition& definition)
+        {
+            Model model;
+            model.personCount = definition.persons.size();
+            model.attrTypeCount = definition.attributes.size();
+            if (model.personCount > maxPersons || model.attrTypeCount > maxAttrTypes || definition.constraints.size() > maxConstraints)
+                throw SolverConfigError("Too big puzzle for the constexpr solver");
+
+            auto typeIndex = [&definition](const std::string& type)
+                {
+                    const auto found = std::find_if(definition.attributes.begin(), definition.attributes.end(),
+                        [&type](const PuzzleDefinition::AttributeDescription& description) { return description.type == type; });
+                    if (found == definition.attributes.end())
+                        throw PuzzleLogicError("Unexpected attribute type in the puzzle definition");
+                    return static_cast<size_t>(found - definition.attributes.begin());
+                };
+            auto ref = [&definition, &model, &typeIndex](const PuzzleDefinition::Attribute& attr)
+                {
+                    if (attr.type == PuzzleDefinition::personTypeName)
+                        return Ref{ model.attrTypeCount, indexOf(definition.persons, attr.value) };
+
+                    const auto type = typeIndex(attr.type);
+                    return Ref{ type, indexOf(definition.attributes[type].values, attr.value) };
+                };
+            auto lastType = [&model](const Ref& ref, size_t current)
+                {
+                    return ref.type < model.attrTypeCount ? std::max(ref.type, current) : current;
+                };
+
+            for (const auto& definitionConstraint : definition.constraints)
+            {
+                auto& constraint = model.constraints[model.constraintCount++];
+                if (const auto* fact = std::get_if<PuzzleDefinition::Fact>(&definitionConstraint))
+                {
+                    constraint.first = ref(fact->first);
+                    constraint.second = ref(fact->second);
+                    constraint.negate = fact->secondNegate;
+                }
+                else
+                {
+                    const auto& comparison = std::get<PuzzleDefinition::Comparison>(definitionConstraint);
+                    constraint.first = ref(comparison.first);
+                    constraint.second = ref(comparison.second);
+                    constraint.isComparison = true;
+                    constraint.compareBy = typeIndex(comparison.compareBy);
+                    constraint.relation = comparison.relation;
+                }
+                constraint.lastType = lastType(constraint.second, lastType(constraint.first, constraint.isComparison ? constraint.compareBy : 0));
+            }
+            return model;
+        }
+
+        // Current partial assignment: owners of values and positions (values) of persons, per attribute type
+        struct State
+        {
+            std::array<std::array<std::uint8_t, maxPersons>, maxAttrTypes> owners{};
+            std::array<std::array<std::uint8_t, maxPersons>, maxAttrTypes> positions{};
+
+            constexpr size_t person(const Ref& ref, size_t attrTypeCount) const
+            {
+                return ref.type == attrTypeCount ? ref.index : owners[ref.type][ref.index];
+            }
+        };
+
+        constexpr bool satisfied(const Constraint& constraint, const State& state, size_t attrTypeCount)
+        {
+            const auto person1 = state.person(constraint.first, attrTypeCount);
+            const auto person2 = state.person(constraint.second, attrTypeCount);
+            if (!constraint.isComparison)
+                return (person1 == person2) != constraint.negate;
+
+            const auto& positions = state.positions[constraint.compareBy];
+            return relationHolds(constraint.relation, positions[person1], positions[person2]);
+        }
+
+        template <size_t Capacity>
+        constexpr void search(const Model& model, size_t type, State& state, Solutions<Capacity>& result)
+        {
+            if (type == model.attrTypeCount)
+            {
+                if (result.count < Capacity)
+                    result.solutions[result.count].owners = state.owners;
+                ++result.count;
+                return;
+            }
+
+            auto& owners = state.owners[type];
+            std::iota(owners.begin(), owners.end(), std::uint8_t{ 0 }); // the first personCount are permuted
+            do
+            {
+                for (size_t value = 0; value < model.personCount; ++value)
+                    state.positions[type][owners[value]] = static_cast<std::uint8_t>(value);
+
+                const bool valid = std::all_of(model.constraints.begin(), model.constraints.begin() + model.constraintCount,
+                    [&model, &state, type](const Constraint& constraint)
+                    {
+                        return constraint.lastType != type || satisfied(constraint, state, model.attrTypeCount);
+                    });
+                if (valid)
+                    search(model, type + 1, state, result);
+            } while (std::next_permutation(owners.begin(), owners.begin() + model.personCount));
+        }
+    } // namespace details
+
+        // Solve at compile time (or at runtime): all solutions are counted, the first Capacity are stored.
+        template <size_t Capacity = 0>
+        constexpr Solutions<Capacity> solve(const PuzzleDefinition& definition)
+        {
+            const auto model = details::makeModel(definition);
+            details::State state;
+            Solutions<Capacity> result;
+            details::search(model, 0, state, result);
+            return result;
+        }
+
+        constexpr std::uint64_t countSolutions(const PuzzleDefinition& definition)
+        {
+            return solve<0>(definition).count;
+        }
+    }
+}
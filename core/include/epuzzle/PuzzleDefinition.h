@@ -66,6 +66,9 @@ namespace epuzzle
 
     void normalize(PuzzleDefinition&);
     void validate(const PuzzleDefinition&); // throw PuzzleLogicError
+    // SHA-256 (hex) of the canonical form: the same for the puzzles that differ only in the labels, in the order of persons, attributes,
+    // values and constraints, and in the symmetric forms of comparisons (see ResultCache). Throw PuzzleLogicError as validate
+    std::string fingerprint(PuzzleDefinition);
 
     std::ostream& operator<<(std::ostream&, const PuzzleDefinition&);
 }
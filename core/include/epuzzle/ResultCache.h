@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace epuzzle
+{
+
+    // Solutions of the solved puzzles by the canonical form of the puzzle (see fingerprint): a puzzle that differs only in the labels,
+    // in the order of persons, attributes, values and constraints gets the cached solutions with its own labels, without preparation.
+    // Only the exhaustive methods (BruteForce, Counting, RelationalJoin: the same solutions whatever the options) use and fill it;
+    // canceled, checkpointed and sharded searches are not cached. In memory; with a directory - on disk too, a file per puzzle
+    // (shared by processes and runs). Thread-safe, must outlive the solvers using it (see Solver::create).
+    class ResultCache
+    {
+    public:
+        // The solution sets are kept in their product form (see SolutionSet): the parts of more partial solutions are not kept, only the count
+        static constexpr size_t maxSolutions = 10'000;
+
+        ResultCache(); // in memory only
+        explicit ResultCache(std::filesystem::path directory); // created if missing
+        ~ResultCache();
+        ResultCache(const ResultCache&) = delete;
+        ResultCache& operator=(const ResultCache&) = delete;
+
+        struct Stats
+        {
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+            size_t entries = 0; // in memory
+        };
+        Stats stats() const;
+        void clear(); // the memory and the statistics (the files stay)
+
+        struct Data; // internal
+        Data& data() { return *m_data; }
+
+    private:
+        std::unique_ptr<Data> m_data;
+    };
+
+}
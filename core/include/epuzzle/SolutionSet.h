@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "PuzzleSolution.h"
+
+namespace epuzzle
+{
+
+    // Set of puzzle solutions in product form. Each solution is a combination of one partial solution from each part,
+    // where parts are solutions of independent sub-puzzles (the same persons, disjoint attribute types).
+    // Besides, values of a symmetry group are interchangeable: any permutation of their owners gives another solution.
+    // Then parts contain canonical solutions only, each of them represents a class of multiplicity() solutions.
+    // The size is known instantly, solutions are combined lazily on access.
+    // The parts may be found with an attribute type as the persons (see Pivot): the solutions are mapped back on access.
+    class SolutionSet
+    {
+    public:
+        // Values of one attribute type that no constraint distinguishes
+        struct ValueGroup
+        {
+            std::string type;
+            std::vector<std::string> values;
+        };
+
+        // The parts were solved with the `type` values as the persons and the persons as the `type` values:
+        // the `person` row and the `type` row are swapped back, the columns are ordered as `persons`
+        struct Pivot
+        {
+            std::string type;
+            std::vector<std::string> persons;
+        };
+
+        SolutionSet() = default;
+        explicit SolutionSet(std::vector<PuzzleSolution>); // plain list (one part)
+        // attributeOrder - attribute types (without `person`) in the order of the combined solution
+        SolutionSet(std::vector<std::vector<PuzzleSolution>> parts, std::vector<std::string> attributeOrder,
+            std::vector<ValueGroup> symmetry = {}); // throw on uint64 size overflow
+
+        std::uint64_t size() const; // classCount() * multiplicity()
+        bool empty() const;
+
+        std::uint64_t classCount() const; // count of solutions distinct up to the symmetry
+        std::uint64_t multiplicity() const; // count of solutions in each class
+        const std::vector<ValueGroup>& symmetry() const;
+        PuzzleSolution representative(std::uint64_t classIndex) const; // canonical solution of the class
+        std::vector<PuzzleSolution> representatives() const;
+
+        // Index = classIndex * multiplicity() + index of the values permutation inside the class.
+        // Class index is a mixed-radix number: digit i - index of the partial solution in part i (the first part is the least significant)
+        PuzzleSolution operator[](std::uint64_t index) const;
+        std::vector<PuzzleSolution> toVector() const; // materialize all solutions
+
+        void setPivot(Pivot);
+
+        // The product form itself (e.g. to store the set, see ResultCache)
+        const std::vector<std::vector<PuzzleSolution>>& parts() const;
+        const std::optional<Pivot>& pivot() const;
+
+    private:
+        PuzzleSolution combine(std::uint64_t classIndex) const; // canonical solution of the class, as the parts are
+        PuzzleSolution unpivot(PuzzleSolution) const;
+
+    private:
+        std::vector<std::vector<PuzzleSolution>> m_parts;
+        std::vector<std::string> m_attributeOrder;
+        std::vector<ValueGroup> m_symmetry;
+        std::optional<Pivot> m_pivot;
+        std::uint64_t m_classCount = 0;
+        std::uint64_t m_multiplicity = 1;
+    };
+
+}
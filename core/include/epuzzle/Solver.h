@@ -1,21 +1,34 @@
 #pragma once
 #include <chrono>
 #include <cstdint>
+#include <filesystem>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "SolverConfig.h"
 #include "PuzzleDefinition.h"
 #include "PuzzleSolution.h"
+#include "SolutionSet.h"
 
 namespace epuzzle
 {
+    class CompiledPuzzle;
+    class ResultCache;
 
     // The main interface for client code.
     class Solver
     {
     public:
         static std::unique_ptr<Solver> create(SolverConfig, PuzzleDefinition);
+        // No parsing and preparation if the config is the one the puzzle is compiled with (see CompiledPuzzle)
+        static std::unique_ptr<Solver> create(SolverConfig, const CompiledPuzzle&);
+        // The cached solutions of the same puzzle up to the labels and the order, without preparation, or a solver filling the cache
+        // (see ResultCache). The cache must outlive the solver
+        static std::unique_ptr<Solver> create(SolverConfig, PuzzleDefinition, ResultCache&);
         virtual ~Solver() = default;
 
         // Parameter object. The callback executes in solve()'s calling thread. Return false to cancel the operation.
@@ -23,8 +36,40 @@ namespace epuzzle
         {
             std::chrono::milliseconds progressInterval = std::chrono::milliseconds(1000);
             std::function<bool(std::uint64_t total, std::uint64_t current)> progressCallback = [](auto, auto) { return true; };
+            // Checkpoints of long searches (parallel BruteForce, other solvers ignore them): the processed ranges and the solutions
+            // found in them are saved to the file periodically and when the search ends or is canceled. Empty path - no checkpoints.
+            std::filesystem::path checkpointFile = {};
+            std::chrono::milliseconds checkpointInterval = std::chrono::minutes(1);
+            bool resume = false; // skip the ranges processed according to the checkpoint file (if exists). Throw if it is of another search
+
+            // Sharding of one search across processes or hosts (parallel BruteForce): only the slice `index` of `count` about equal,
+            // wheel-aligned slices of the search space is searched. Its checkpoint file is the shard result (see mergeShards).
+            struct Shard
+            {
+                size_t index = 0;
+                size_t count = 1;
+            };
+            std::optional<Shard> shard = {};
         };
         virtual std::vector<PuzzleSolution> solve(const SolveOptions&) = 0;
+
+        // Solutions in product form (see SolutionSet). By default - the plain list of solve(); solvers decomposing the puzzle
+        // into independent sub-puzzles return the product of their solutions without materializing it.
+        virtual SolutionSet solveSet(const SolveOptions& opts) { return SolutionSet{ solve(opts) }; }
+
+        // Count-only solve. By default - the size of solveSet() (not materialized); the Counting method counts without enumeration.
+        // Return 0 if canceled.
+        virtual std::uint64_t countSolutions(const SolveOptions& opts) { return solveSet(opts).size(); }
+
+        // Human-readable preparation details (search space size, presolve results, etc.): list of name -> value.
+        using Statistics = std::vector<std::pair<std::string, std::string>>;
+        virtual Statistics statistics() const { return {}; }
     };
 
+    // Combine the checkpoint files of all shards of one search (see SolveOptions::shard) into one checkpoint file: the full search
+    // space is done, duplicate solutions (of overlapping shards) are dropped. Solving with it (resume) returns all the solutions.
+    // The parts of a decomposed puzzle (files <name>.partN) are merged part by part.
+    // Throw SolverConfigError if a file is missing, the files are of different searches, or some range is not covered.
+    void mergeShards(const std::vector<std::filesystem::path>& shardFiles, const std::filesystem::path& mergedFile);
+
 }
@@ -0,0 +1,13 @@
+#pragma once
+#include <ostream>
+
+#include "PuzzleDefinition.h"
+
+namespace epuzzle
+{
+    // Ahead-of-time puzzle compilation: writes a standalone C++ program (one translation unit, the standard library only)
+    // which solves this puzzle only. Wheels (see bruteforce SearchSpace) are hardcoded tables of packed permutations,
+    // constraints are inline expressions in a nested loop per wheel, each checked as soon as its wheels are bound.
+    // The program prints all solutions and their count. Up to 8 persons (throw SolverConfigError), throw PuzzleLogicError.
+    void generateSolverSource(PuzzleDefinition, std::ostream& cppSource);
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <chrono>
 #include <cstdint>
 #include <optional>
 #include <ostream>
@@ -11,7 +12,10 @@ namespace epuzzle
         enum class SolvingMethod : std::uint8_t
         {
             BruteForce,
-            Deductive
+            Deductive,
+            LocalSearch,
+            Counting, // exact search with propagation; counts solutions without enumeration (see Solver::countSolutions)
+            RelationalJoin // bruteforce wheels joined as relations, constraints are join predicates (uses BruteForceConfig)
         };
 
         struct BruteForceConfig
@@ -22,12 +26,35 @@ namespace epuzzle
                 Parallel
             };
 
+            enum class WheelOrder : std::uint8_t
+            {
+                Lexicographic,
+                MinimalChange // Steinhaus-Johnson-Trotter: consecutive permutations differ by one swap, fewer checks to revalidate
+            };
+
             bool prefilter = true;
-            ExecPolicy execution = ExecPolicy::Parallel;
+            bool presolve = true; // deductive propagation narrows person x value domains before wheels generation
+            bool decompose = true; // independent sub-puzzles are solved separately, the result is their product (see SolutionSet)
+            bool breakSymmetry = true; // interchangeable values are searched in canonical order only (see SolutionSet::multiplicity)
+            bool meetInTheMiddle = false; // two halves of the wheels are enumerated separately and joined on cross-half constraints
+            bool pivot = true; // an attribute type becomes the fixed axis instead of the persons (see choosePivotAxis)
+            ExecPolicy execution = ExecPolicy::Parallel; // ignored by RelationalJoin (sequential); so is decompose
+            WheelOrder wheelOrder = WheelOrder::Lexicographic;
+        };
+
+        // Stochastic min-conflicts search: finds one solution (if lucky) without completeness guarantee. For huge puzzles.
+        struct LocalSearchConfig
+        {
+            std::uint64_t seed = 1; // the same seed gives the same search path (reproducibility)
+            std::chrono::milliseconds timeBudget = std::chrono::seconds(10);
+            std::uint32_t tabuTenure = 8; // recently moved values are frozen for this count of steps
+            double randomWalkProbability = 0.1; // probability of a random move instead of the best one
         };
 
         SolvingMethod solvingMethod = SolvingMethod::BruteForce;
-        std::optional<BruteForceConfig> bruteForce;
+        std::optional<BruteForceConfig> bruteForce = {};
+        std::optional<LocalSearchConfig> localSearch = {};
+        bool probing = false; // failed-literal probing presolve before any solving method: slower preparation, but prunes much more
     };
 
     void validate(const SolverConfig&); // throw SolverConfigError
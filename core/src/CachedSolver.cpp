@@ -0,0 +1,118 @@
+#include "CachedSolver.h"
+
+namespace epuzzle::details
+{
+namespace
+{
+    using Entry = ResultCache::Data::Entry;
+
+    // Checkpoints and shards are of the search itself, not of its result
+    bool bypassed(const Solver::SolveOptions& opts)
+    {
+        return !opts.checkpointFile.empty() || opts.shard.has_value();
+    }
+}
+
+    CachedSolver::CachedSolver(ResultCache::Data& cache, CanonicalPuzzle canonical, ResultCache::Data::SharedEntry cached, SolverFactory factory)
+        : m_cache(cache)
+        , m_canonical(std::move(canonical))
+        , m_cached(std::move(cached))
+        , m_factory(std::move(factory))
+    {
+        if (!m_cached)
+            m_solver = m_factory(); // the preparation statistics are available before solving, as without the cache
+    }
+
+    Solver& CachedSolver::solver()
+    {
+        if (!m_solver)
+            m_solver = m_factory();
+        return *m_solver;
+    }
+
+    std::optional<SolutionSet> CachedSolver::cachedSolutions(const SolveOptions& opts)
+    {
+        if (bypassed(opts) || !m_cached || !m_cached->solutions)
+            return {};
+        m_cache.countLookup(true);
+        auto solutions = m_canonical.fromCanonical(*m_cached->solutions);
+        opts.progressCallback(1, 1);
+        return solutions;
+    }
+
+    // ToEntry(result) - the entry of a finished search
+    template <typename Result, typename Solve, typename ToEntry>
+    Result CachedSolver::solveAndCache(const SolveOptions& opts, Solve solve, ToEntry toEntry)
+    {
+        if (bypassed(opts))
+            return solve(solver(), opts);
+
+        m_cache.countLookup(false);
+        bool canceled = false;
+        auto tracked = opts;
+        tracked.progressCallback = [&opts, &canceled](std::uint64_t total, std::uint64_t current)
+            {
+                const bool proceed = opts.progressCallback(total, current);
+                canceled = canceled || !proceed;
+                return proceed;
+            };
+        auto result = solve(solver(), tracked);
+        if (!canceled)
+        {
+            Entry entry = toEntry(result);
+            entry.form = m_canonical.form();
+            m_cached = m_cache.add(m_canonical, std::move(entry));
+        }
+        return result;
+    }
+
+    // The set is cached (its product form, not the solutions): expanded as the solvers do
+    std::vector<PuzzleSolution> CachedSolver::solve(const SolveOptions& opts)
+    {
+        return solveSet(opts).toVector();
+    }
+
+    SolutionSet CachedSolver::solveSet(const SolveOptions& opts)
+    {
+        if (auto cached = cachedSolutions(opts))
+            return std::move(*cached);
+
+        return solveAndCache<SolutionSet>(opts, [](Solver& solver, const SolveOptions& options) { return solver.solveSet(options); },
+            [this](const SolutionSet& solutions)
+            {
+                Entry entry{ .form = {}, .count = solutions.size(), .solutions = std::nullopt };
+                const auto partials = std::accumulate(solutions.parts().begin(), solutions.parts().end(), size_t{ 0 },
+                    [](size_t sum, const auto& part) { return sum + part.size(); });
+                if (partials <= ResultCache::maxSolutions)
+                    entry.solutions = m_canonical.toCanonical(solutions);
+                return entry;
+            });
+    }
+
+    std::uint64_t CachedSolver::countSolutions(const SolveOptions& opts)
+    {
+        if (!bypassed(opts) && m_cached)
+        {
+            m_cache.countLookup(true);
+            opts.progressCallback(1, 1);
+            return m_cached->count;
+        }
+
+        return solveAndCache<std::uint64_t>(opts, [](Solver& solver, const SolveOptions& options) { return solver.countSolutions(options); },
+            [](std::uint64_t count) { return Entry{ .form = {}, .count = count, .solutions = std::nullopt }; });
+    }
+
+    Solver::Statistics CachedSolver::statistics() const
+    {
+        const auto fingerprint = m_canonical.hash().substr(0, 16);
+        if (!m_solver)
+        {
+            const auto* kept = m_cached->solutions ? "" : ", the count only";
+            return { { "Result cache", "hit, fingerprint " + fingerprint + ", " + std::to_string(m_cached->count) + " solutions" + kept + " (no preparation)" } };
+        }
+        Statistics stats{ { "Result cache", "miss, fingerprint " + fingerprint } };
+        std::ranges::move(m_solver->statistics(), std::back_inserter(stats));
+        return stats;
+    }
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "epuzzle/ResultCache.h"
+#include "epuzzle/Solver.h"
+#include "CanonicalPuzzle.h"
+
+namespace epuzzle
+{
+
+    struct ResultCache::Data
+    {
+        // Solutions of a canonical puzzle
+        struct Entry
+        {
+            std::string form; // the canonical form: the hash collisions are misses
+            std::uint64_t count = 0;
+            std::optional<details::CanonicalPuzzle::SolutionSetForm> solutions; // none if only counted or too many
+        };
+        using SharedEntry = std::shared_ptr<const Entry>;
+
+        explicit Data(std::optional<std::filesystem::path> dir)
+            : directory(std::move(dir))
+        {
+        }
+
+        SharedEntry find(const details::CanonicalPuzzle&); // in memory, then on disk
+        SharedEntry add(const details::CanonicalPuzzle&, Entry); // an entry with the solutions is not replaced by a count-only one
+        void countLookup(bool hit);
+
+        const std::optional<std::filesystem::path> directory;
+        mutable std::mutex guard;
+        std::map<std::string, SharedEntry> entries; // by hash
+        Stats stats;
+    };
+
+    namespace details
+    {
+        // Solver over a result cache (see ResultCache): the cached solutions of the canonical puzzle relabeled as the definition,
+        // or the solver (created on the first miss) solves and fills the cache.
+        class CachedSolver final : public Solver
+        {
+        public:
+            using SolverFactory = std::function<std::unique_ptr<Solver>()>;
+            // cached - of the canonical puzzle, may be empty: then the solver is created at once
+            CachedSolver(ResultCache::Data&, CanonicalPuzzle, ResultCache::Data::SharedEntry cached, SolverFactory);
+
+            std::vector<PuzzleSolution> solve(const SolveOptions&) override;
+            SolutionSet solveSet(const SolveOptions&) override;
+            std::uint64_t countSolutions(const SolveOptions&) override;
+            Statistics statistics() const override;
+
+        private:
+            Solver& solver();
+            std::optional<SolutionSet> cachedSolutions(const SolveOptions&); // none if not cached or bypassed
+            template <typename Result, typename Solve, typename ToEntry>
+            Result solveAndCache(const SolveOptions&, Solve, ToEntry);
+
+        private:
+            ResultCache::Data& m_cache;
+            const CanonicalPuzzle m_canonical;
+            ResultCache::Data::SharedEntry m_cached;
+            const SolverFactory m_factory;
+            std::unique_ptr<Solver> m_solver;
+        };
+    }
+
+}
@@ -0,0 +1,455 @@
+#include "CanonicalPuzzle.h"
+
+namespace epuzzle::details
+{
+namespace
+{
+    using Relation = PuzzleDefinition::Comparison::Relation;
+    using Signature = std::vector<std::uint64_t>;
+    constexpr size_t none = std::numeric_limits<size_t>::max();
+
+    std::string sha256(std::string_view message)
+    {
+        static constexpr std::array<std::uint32_t, 64> roundConstants
+        {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+        std::array<std::uint32_t, 8> state{ 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+        // Padding: 0x80, zeros, the message length in bits (big-endian) - to whole 64-byte blocks
+        std::string data(message);
+        data.push_back(static_cast<char>(0x80));
+        while (data.size() % 64 != 56)
+            data.push_back('\0');
+        const std::uint64_t bitLength = std::uint64_t{ message.size() } * 8;
+        for (int shift = 56; shift >= 0; shift -= 8)
+            data.push_back(static_cast<char>(bitLength >> shift));
+
+        for (size_t block = 0; block < data.size(); block += 64)
+        {
+            std::array<std::uint32_t, 64> schedule{};
+            for (size_t i = 0; i < 16; ++i)
+            {
+                for (size_t byte = 0; byte < 4; ++byte)
+                    schedule[i] = (schedule[i] << 8) | static_cast<std::uint8_t>(data[block + i * 4 + byte]);
+            }
+            for (size_t i = 16; i < 64; ++i)
+            {
+                const auto s0 = std::rotr(schedule[i - 15], 7) ^ std::rotr(schedule[i - 15], 18) ^ (schedule[i - 15] >> 3);
+                const auto s1 = std::rotr(schedule[i - 2], 17) ^ std::rotr(schedule[i - 2], 19) ^ (schedule[i - 2] >> 10);
+                schedule[i] = schedule[i - 16] + s0 + schedule[i - 7] + s1;
+            }
+
+            auto [a, b, c, d, e, f, g, h] = state;
+            for (size_t i = 0; i < 64; ++i)
+            {
+                const auto t1 = h + (std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25)) + ((e & f) ^ (~e & g)) + roundConstants[i] + schedule[i];
+                const auto t2 = (std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                h = g;
+                g = f;
+                f = e;
+                e = d + t1;
+                d = c;
+                c = b;
+                b = a;
+                a = t1 + t2;
+            }
+            const std::array<std::uint32_t, 8> added{ a, b, c, d, e, f, g, h };
+            for (size_t i = 0; i < state.size(); ++i)
+                state[i] += added[i];
+        }
+
+        std::ostringstream hex;
+        for (const auto word : state)
+            hex << std::hex << std::setw(8) << std::setfill('0') << word;
+        return hex.str();
+    }
+
+    // A constraint between the nodes: facts and Adjacent are symmetric, the other comparisons are in the ImmediateLeft/Before form
+    struct Link
+    {
+        std::uint64_t kind = 0; // 0 - fact, 1 - negated fact, 2 + relation - comparison
+        size_t first = 0;
+        size_t second = 0;
+        size_t compareBy = none; // type node
+        bool symmetric = true;
+    };
+
+    // The types and the values are the nodes of one colored graph, the constraints are its links. The colors are refined by the
+    // colors of the neighbours until stable; if some nodes are still of one color, one of them gets a color of its own, and so on.
+    // The colors depend on the structure only, so the discrete coloring is the canonical order (up to the individualized ties).
+    class Graph
+    {
+    public:
+        Graph(size_t typeCount, size_t valueCount, std::vector<Link> links, const std::vector<bool>& ordered)
+            : m_typeCount(typeCount)
+            , m_valueCount(valueCount)
+            , m_links(std::move(links))
+            , m_incident(typeCount + typeCount * valueCount)
+        {
+            for (size_t index = 0; index < m_links.size(); ++index)
+            {
+                const auto& link = m_links[index];
+                m_incident[link.first].push_back(index);
+                m_incident[link.second].push_back(index);
+                if (link.compareBy != none)
+                    m_incident[link.compareBy].push_back(index);
+            }
+
+            // The persons type first, the values of a compared-by type are ordered by positions
+            std::vector<Signature> initial(m_incident.size());
+            for (size_t type = 0; type < typeCount; ++type)
+            {
+                initial[type] = { 0, type == 0 ? 0u : 1u, ordered[type] ? 1u : 0u };
+                for (size_t value = 0; value < valueCount; ++value)
+                    initial[valueNode(type, value)] = { 1, type == 0 ? 0u : 1u, ordered[type] ? 1u : 0u, ordered[type] ? value : 0u };
+            }
+            m_classCount = recolor(initial);
+        }
+
+        size_t valueNode(size_t type, size_t value) const { return m_typeCount + type * m_valueCount + value; }
+
+        // Node -> canonical color, all different
+        const std::vector<std::uint64_t>& discreteColors()
+        {
+            refine();
+            while (m_classCount < m_colors.size())
+            {
+                // The first class of several nodes: if they are interchangeable, it makes no difference which one is chosen
+                std::map<std::uint64_t, size_t> classSizes;
+                for (const auto color : m_colors)
+                    ++classSizes[color];
+                const auto tied = std::ranges::find_if(classSizes, [](const auto& entry) { return entry.second > 1; })->first;
+                const auto chosen = static_cast<size_t>(std::ranges::find(m_colors, tied) - m_colors.begin());
+
+                std::vector<Signature> individualized(m_colors.size());
+                for (size_t node = 0; node < m_colors.size(); ++node)
+                    individualized[node] = { m_colors[node], (m_colors[node] == tied && node != chosen) ? 1u : 0u };
+                m_classCount = recolor(individualized);
+                refine();
+            }
+            return m_colors;
+        }
+
+    private:
+        void refine()
+        {
+            while (true)
+            {
+                std::vector<Signature> signatures(m_colors.size());
+                for (size_t node = 0; node < m_colors.size(); ++node)
+                    signatures[node] = signature(node);
+                const auto classCount = recolor(signatures);
+                if (classCount == m_classCount)
+                    return;
+                m_classCount = classCount;
+            }
+        }
+
+        // The own color first: the classes are only split, in the order of the previous colors
+        Signature signature(size_t node) const
+        {
+            auto colorOf = [this](size_t other) { return other == none ? std::numeric_limits<std::uint64_t>::max() : m_colors[other]; };
+            std::vector<std::array<std::uint64_t, 4>> neighbours;
+            if (node < m_typeCount)
+            {
+                for (size_t value = 0; value < m_valueCount; ++value)
+                    neighbours.push_back({ 0, m_colors[valueNode(node, value)], 0, 0 });
+            }
+            else
+                neighbours.push_back({ 1, m_colors[(node - m_typeCount) / m_valueCount], 0, 0 });
+
+            for (const auto index : m_incident[node])
+            {
+                const auto& link = m_links[index];
+                if (link.compareBy == node)
+                {
+                    auto [first, second] = std::pair{ colorOf(link.first), colorOf(link.second) };
+                    if (link.symmetric && second < first)
+                        std::swap(first, second);
+                    neighbours.push_back({ 2, link.kind, first, second });
+                }
+                else if (link.first == node)
+                    neighbours.push_back({ 3, link.kind, colorOf(link.second), colorOf(link.compareBy) });
+                else
+                    neighbours.push_back({ link.symmetric ? 3u : 4u, link.kind, colorOf(link.first), colorOf(link.compareBy) });
+            }
+            std::ranges::sort(neighbours);
+
+            Signature result{ m_colors[node] };
+            for (const auto& neighbour : neighbours)
+                result.insert(result.end(), neighbour.begin(), neighbour.end());
+            return result;
+        }
+
+        // Color - rank of the signature. Return the count of colors
+        size_t recolor(const std::vector<Signature>& signatures)
+        {
+            std::map<Signature, std::uint64_t> ranks;
+            for (const auto& signature : signatures)
+                ranks.emplace(signature, 0);
+            std::uint64_t rank = 0;
+            for (auto& entry : ranks)
+                entry.second = rank++;
+            m_colors.resize(signatures.size());
+            for (size_t node = 0; node < signatures.size(); ++node)
+                m_colors[node] = ranks[signatures[node]];
+            return ranks.size();
+        }
+
+    private:
+        const size_t m_typeCount;
+        const size_t m_valueCount;
+        const std::vector<Link> m_links;
+        std::vector<std::vector<size_t>> m_incident; // node -> links
+        std::vector<std::uint64_t> m_colors;
+        size_t m_classCount = 0;
+    };
+
+    size_t findIndex(const std::vector<std::string>& names, std::string_view name)
+    {
+        const auto found = std::ranges::find(names, name);
+        ENSURE(found != names.end(), "Unknown name: " << name);
+        return static_cast<size_t>(found - names.begin());
+    }
+} // namespace
+
+    CanonicalPuzzle::CanonicalPuzzle(const PuzzleDefinition& definition)
+    {
+        m_types.emplace_back(PuzzleDefinition::personTypeName, definition.persons);
+        m_types.insert(m_types.end(), definition.attributes.begin(), definition.attributes.end());
+        const auto typeCount = m_types.size();
+        const auto valueCount = definition.persons.size();
+
+        std::vector<std::string> typeNames;
+        std::ranges::transform(m_types, std::back_inserter(typeNames), &PuzzleDefinition::AttributeDescription::type);
+        auto typeIndex = [&typeNames](const std::string& type) { return findIndex(typeNames, type); };
+        auto valueIndex = [this, &typeIndex](const PuzzleDefinition::Attribute& attr)
+            {
+                const auto type = typeIndex(attr.type);
+                return std::pair{ type, findIndex(m_types[type].values, attr.value) };
+            };
+
+        std::vector<std::pair<std::pair<size_t, size_t>, std::pair<size_t, size_t>>> endpoints; // of the links: (type, value)
+        std::vector<Link> links;
+        std::vector<bool> ordered(typeCount);
+        for (const auto& constraint : definition.constraints)
+        {
+            std::visit(utils::overloaded
+                {
+                    [&](const PuzzleDefinition::Fact& fact)
+                    {
+                        endpoints.emplace_back(valueIndex(fact.first), valueIndex(fact.second));
+                        links.push_back({ .kind = fact.secondNegate ? 1u : 0u, .first = 0, .second = 0, .compareBy = none, .symmetric = true });
+                    },
+                    [&](const PuzzleDefinition::Comparison& comparison)
+                    {
+                        auto first = valueIndex(comparison.first);
+                        auto second = valueIndex(comparison.second);
+                        auto relation = comparison.relation;
+                        if (relation == Relation::ImmediateRight || relation == Relation::After)
+                        {
+                            std::swap(first, second);
+                            relation = (relation == Relation::After) ? Relation::Before : Relation::ImmediateLeft;
+                        }
+                        const auto compareBy = typeIndex(comparison.compareBy);
+                        ordered[compareBy] = true;
+                        endpoints.emplace_back(first, second);
+                        links.push_back({ .kind = 2u + static_cast<std::uint64_t>(relation), .first = 0, .second = 0, .compareBy = compareBy,
+                            .symmetric = relation == Relation::Adjacent });
+                    },
+                }, constraint);
+        }
+
+        auto nodeLinks = links;
+        for (size_t index = 0; index < links.size(); ++index)
+        {
+            const auto& [first, second] = endpoints[index];
+            nodeLinks[index].first = typeCount + first.first * valueCount + first.second;
+            nodeLinks[index].second = typeCount + second.first * valueCount + second.second;
+        }
+        Graph graph{ typeCount, valueCount, std::move(nodeLinks), ordered };
+        const auto& colors = graph.discreteColors();
+
+        // Canonical order: by the colors
+        std::vector<size_t> typeOrder(typeCount);
+        std::iota(typeOrder.begin(), typeOrder.end(), size_t{ 0 });
+        std::ranges::sort(typeOrder, std::less{}, [&colors](size_t type) { return colors[type]; });
+        m_canonicalType.resize(typeCount);
+        m_canonicalValue.assign(typeCount, std::vector<std::uint32_t>(valueCount));
+        m_originalValue.assign(typeCount, std::vector<std::uint32_t>(valueCount));
+        for (size_t type = 0; type < typeCount; ++type)
+        {
+            m_canonicalType[typeOrder[type]] = type;
+            auto& values = m_originalValue[type];
+            std::iota(values.begin(), values.end(), std::uint32_t{ 0 });
+            std::ranges::sort(values, std::less{}, [&graph, &colors, type](std::uint32_t value) { return colors[graph.valueNode(type, value)]; });
+            for (std::uint32_t value = 0; value < valueCount; ++value)
+                m_canonicalValue[type][values[value]] = value;
+        }
+        ENSURE(m_canonicalType[0] == 0, "The persons must be the first canonical type");
+
+        // (kind, first type, first value, second type, second value, compared-by type)
+        std::vector<std::array<size_t, 6>> constraints;
+        for (size_t index = 0; index < links.size(); ++index)
+        {
+            auto canonical = [this](std::pair<size_t, size_t> attr)
+                { return std::pair<size_t, size_t>{ m_canonicalType[attr.first], m_canonicalValue[attr.first][attr.second] }; };
+            auto first = canonical(endpoints[index].first);
+            auto second = canonical(endpoints[index].second);
+            if (links[index].symmetric && second < first)
+                std::swap(first, second);
+            const auto compareBy = links[index].compareBy == none ? none : m_canonicalType[links[index].compareBy];
+            constraints.push_back({ links[index].kind, first.first, first.second, second.first, second.second, compareBy });
+        }
+        std::ranges::sort(constraints);
+        const auto [duplicates, end] = std::ranges::unique(constraints);
+        constraints.erase(duplicates, end);
+
+        std::ostringstream form;
+        form << "persons " << valueCount << ", attributes " << typeCount - 1 << ";";
+        for (const auto& constraint : constraints)
+        {
+            form << " " << constraint[0] << ":" << constraint[1] << "." << constraint[2] << "-" << constraint[3] << "." << constraint[4];
+            if (constraint[5] != none)
+                form << "@" << constraint[5];
+        }
+        m_form = form.str();
+        m_hash = sha256(m_form);
+    }
+
+    size_t CanonicalPuzzle::findType(std::string_view name) const
+    {
+        const auto found = std::ranges::find(m_types, name, &PuzzleDefinition::AttributeDescription::type);
+        ENSURE(found != m_types.end(), "Unknown name: " << name);
+        return static_cast<size_t>(found - m_types.begin());
+    }
+
+    CanonicalPuzzle::Solution CanonicalPuzzle::toCanonical(const PuzzleSolution& solution, size_t frame) const
+    {
+        const auto persons = std::ranges::find(solution.attributes, std::string_view(PuzzleSolution::personTypeName), &PuzzleSolution::Attribute::type);
+        ENSURE(persons != solution.attributes.end() && solution.attributes.size() <= m_types.size(), "Unexpected solution of the puzzle");
+
+        Solution canonical(m_types.size() - 1);
+        for (const auto& row : solution.attributes)
+        {
+            const auto type = findType(row.type);
+            if (type == 0)
+                continue;
+            ENSURE(row.values.size() == persons->values.size() && row.values.size() == m_types[frame].values.size(), "Unexpected solution of the puzzle");
+            const auto rowType = valueType(type, frame);
+            auto& values = canonical[m_canonicalType[type] - 1];
+            values.resize(row.values.size());
+            for (size_t column = 0; column < row.values.size(); ++column)
+            {
+                const auto person = m_canonicalValue[frame][findIndex(m_types[frame].values, persons->values[column])];
+                values[person] = m_canonicalValue[rowType][findIndex(m_types[rowType].values, row.values[column])];
+            }
+        }
+        return canonical;
+    }
+
+    PuzzleSolution CanonicalPuzzle::fromCanonical(const Solution& canonical, size_t frame) const
+    {
+        ENSURE(canonical.size() == m_types.size() - 1, "Unexpected canonical solution of the puzzle");
+        PuzzleSolution solution;
+        solution.attributes.reserve(m_types.size());
+        solution.attributes.emplace_back(PuzzleSolution::personTypeName, m_types[frame].values);
+        for (size_t type = 1; type < m_types.size(); ++type)
+        {
+            const auto& row = canonical[m_canonicalType[type] - 1];
+            if (row.empty()) // not of the part
+                continue;
+            const auto rowType = valueType(type, frame);
+            auto& values = solution.attributes.emplace_back(m_types[type].type, std::vector<std::string>{}).values;
+            for (size_t person = 0; person < m_types[frame].values.size(); ++person)
+            {
+                const auto value = row.at(m_canonicalValue[frame][person]);
+                ENSURE(value < m_originalValue[rowType].size(), "Unexpected canonical solution of the puzzle");
+                values.push_back(m_types[rowType].values[m_originalValue[rowType][value]]);
+            }
+        }
+        return solution;
+    }
+
+    CanonicalPuzzle::SolutionSetForm CanonicalPuzzle::toCanonical(const SolutionSet& solutions) const
+    {
+        SolutionSetForm form;
+        const auto frame = solutions.pivot() ? findType(solutions.pivot()->type) : 0;
+        form.pivot = m_canonicalType[frame];
+        for (const auto& part : solutions.parts())
+        {
+            auto& canonicalPart = form.parts.emplace_back();
+            canonicalPart.reserve(part.size());
+            for (const auto& solution : part)
+                canonicalPart.push_back(toCanonical(solution, frame));
+        }
+        for (const auto& group : solutions.symmetry())
+        {
+            const auto type = findType(group.type);
+            const auto rowType = valueType(type, frame);
+            auto& canonicalGroup = form.symmetry.emplace_back(1, static_cast<std::uint32_t>(m_canonicalType[type]));
+            for (const auto& value : group.values)
+                canonicalGroup.push_back(m_canonicalValue[rowType][findIndex(m_types[rowType].values, value)]);
+        }
+        return form;
+    }
+
+    SolutionSet CanonicalPuzzle::fromCanonical(const SolutionSetForm& form) const
+    {
+        auto originalType = [this](size_t canonicalType)
+            {
+                const auto found = std::ranges::find(m_canonicalType, canonicalType);
+                ENSURE(found != m_canonicalType.end(), "Unexpected canonical solution set of the puzzle");
+                return static_cast<size_t>(found - m_canonicalType.begin());
+            };
+        const auto frame = originalType(form.pivot);
+
+        std::vector<std::vector<PuzzleSolution>> parts;
+        parts.reserve(form.parts.size());
+        for (const auto& canonicalPart : form.parts)
+        {
+            auto& part = parts.emplace_back();
+            part.reserve(canonicalPart.size());
+            for (const auto& solution : canonicalPart)
+                part.push_back(fromCanonical(solution, frame));
+        }
+        std::vector<SolutionSet::ValueGroup> symmetry;
+        for (const auto& canonicalGroup : form.symmetry)
+        {
+            ENSURE(!canonicalGroup.empty(), "Unexpected canonical solution set of the puzzle");
+            const auto type = originalType(canonicalGroup.front());
+            const auto rowType = valueType(type, frame);
+            auto& group = symmetry.emplace_back(m_types[type].type, std::vector<std::string>{});
+            for (auto value = canonicalGroup.begin() + 1; value != canonicalGroup.end(); ++value)
+                group.values.push_back(m_types[rowType].values[m_originalValue[rowType].at(*value)]);
+        }
+        std::vector<std::string> attributeOrder;
+        std::transform(m_types.begin() + 1, m_types.end(), std::back_inserter(attributeOrder), [](const auto& type) { return type.type; });
+
+        SolutionSet solutions{ std::move(parts), std::move(attributeOrder), std::move(symmetry) };
+        if (frame != 0)
+            solutions.setPivot({ .type = m_types[frame].type, .persons = m_types.front().values });
+        return solutions;
+    }
+
+}
+
+namespace epuzzle
+{
+
+    std::string fingerprint(PuzzleDefinition definition)
+    {
+        normalize(definition);
+        validate(definition);
+        return details::CanonicalPuzzle{ definition }.hash();
+    }
+
+}
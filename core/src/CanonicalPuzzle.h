@@ -0,0 +1,55 @@
+#pragma once
+#include "epuzzle/PuzzleDefinition.h"
+#include "epuzzle/PuzzleSolution.h"
+#include "epuzzle/SolutionSet.h"
+
+namespace epuzzle::details
+{
+
+    // Canonical form of a puzzle: ids instead of labels, the attribute types and the values in an order given by their role in the
+    // constraints (color refinement, ties broken by individualization), the constraints sorted and deduplicated, comparisons in one
+    // of their symmetric forms (ImmediateRight -> ImmediateLeft, After -> Before, Adjacent and facts unordered). The puzzles differing
+    // only in the labels and in the order of persons, attributes, values and constraints have the same form; the values of a compared-by
+    // type keep their order (positions). Ties of not interchangeable elements may still give different forms: a cache miss, not an error.
+    class CanonicalPuzzle
+    {
+    public:
+        explicit CanonicalPuzzle(const PuzzleDefinition&); // normalized and valid
+
+        const std::string& form() const { return m_form; }
+        const std::string& hash() const { return m_hash; } // SHA-256 of the form, hex
+
+        // Index: canonical attribute type (without the persons) -> canonical person -> canonical value.
+        // A partial solution (of a part, see SolutionSet) has empty rows of the other types. A pivoted one has the persons and
+        // the values of the pivot type swapped: the columns are of its canonical values, its row is of the canonical persons.
+        using Solution = std::vector<std::vector<std::uint32_t>>;
+
+        // Solution set in the canonical form: the same product form (the parts, the symmetry groups, the pivot)
+        struct SolutionSetForm
+        {
+            std::vector<std::vector<Solution>> parts;
+            std::vector<std::vector<std::uint32_t>> symmetry; // a group: the canonical type, then its canonical values
+            size_t pivot = 0; // the canonical type of the pivot axis, 0 - none
+        };
+        SolutionSetForm toCanonical(const SolutionSet&) const;
+        SolutionSet fromCanonical(const SolutionSetForm&) const; // the labels and the order of the definition
+
+    private:
+        // frame - the type whose values are the columns (0 - the persons, else the pivot type)
+        Solution toCanonical(const PuzzleSolution&, size_t frame) const;
+        PuzzleSolution fromCanonical(const Solution&, size_t frame) const;
+        // The type of the values of a row in the frame: the persons and the frame type are swapped
+        static size_t valueType(size_t type, size_t frame) { return type == 0 ? frame : (type == frame ? 0 : type); }
+        size_t findType(std::string_view) const;
+
+    private:
+        // Index: type (0 - the persons, then the attributes of the definition) -> value
+        std::vector<PuzzleDefinition::AttributeDescription> m_types;
+        std::vector<size_t> m_canonicalType; // type -> canonical type
+        std::vector<std::vector<std::uint32_t>> m_canonicalValue; // type -> value -> canonical value
+        std::vector<std::vector<std::uint32_t>> m_originalValue; // type -> canonical value -> value
+        std::string m_form;
+        std::string m_hash;
+    };
+
+}
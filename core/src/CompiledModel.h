@@ -0,0 +1,22 @@
+#pragma once
+#include "epuzzle/CompiledPuzzle.h"
+#include "bruteforce/WheelStore.h"
+#include "PuzzleModel.h"
+
+namespace epuzzle
+{
+
+    // Contents of a compiled puzzle file
+    struct CompiledPuzzle::Data
+    {
+        std::string configText; // the config it is compiled with (printed, see operator<<(SolverConfig))
+        details::PuzzleModel model; // prepared by Solver::create
+        std::unique_ptr<details::bruteforce::WheelStore> wheels; // read-only, may be empty
+    };
+
+    namespace details
+    {
+        void writeCompiledPuzzle(const std::filesystem::path&, const SolverConfig&, const PuzzleModel&, const bruteforce::WheelStore&);
+    }
+
+}
@@ -0,0 +1,495 @@
+#include "epuzzle/Exceptions.h"
+#include "utils/platform/MappedFile.h"
+#include "CompiledModel.h"
+
+namespace epuzzle
+{
+    namespace
+    {
+        using namespace details;
+        using bruteforce::SearchSpace;
+        using bruteforce::WheelStore;
+
+        // Binary format, native byte order (checked by the byte order mark), no padding; numbers are u32 unless noted:
+        //   signature (8 bytes), version, byte order mark
+        //   config text                                - string: length, bytes
+        //   strings                                    - count, strings: all the names interned
+        //   persons                                    - count, name ids
+        //   attributes                                 - count, for each: type name id, values count, value name ids
+        //   definition constraints count               - the first constraints are of the definition, the rest are derived
+        //   constraints                                - count, for each: kind (u8), fields (see writeConstraint)
+        //   wheel sets                                 - count, for each: key (u64), types count, for each type:
+        //                                                permutation size, permutations count, owners (u8 per value)
+        constexpr std::array<char, 8> signature{ 'E', 'P', 'U', 'Z', 'Z', 'L', 'E', 'M' };
+        constexpr std::uint32_t version = 1;
+        constexpr std::uint32_t byteOrderMark = 0x01020304;
+        constexpr std::uint32_t noneId = std::numeric_limits<std::uint32_t>::max();
+
+        enum class ConstraintKind : std::uint8_t
+        {
+            PersonProperty,
+            SameOwner,
+            PositionComparison
+        };
+
+        // The least sizes of the records (see the format), for the counts checks
+        constexpr size_t idSize = sizeof(std::uint32_t);
+        constexpr size_t minAttributeSize = 2 * idSize; // type name id, values count
+        constexpr size_t minConstraintSize = sizeof(ConstraintKind) + 3 * idSize + sizeof(std::uint8_t); // PersonProperty
+        constexpr size_t minWheelSetSize = sizeof(std::uint64_t) + idSize; // key, types count
+        constexpr size_t minWheelSize = 2 * idSize; // permutation size, permutations count
+
+        class Writer
+        {
+        public:
+            explicit Writer(std::ostream& os)
+                : m_os(os)
+            {
+            }
+
+            template <typename T>
+            void write(T value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                m_os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+
+            void writeId(size_t id)
+            {
+                ENSURE(id < noneId, "Too big id for a compiled puzzle: " << id);
+                write(static_cast<std::uint32_t>(id));
+            }
+
+            void writeString(std::string_view str)
+            {
+                writeId(str.size());
+                m_os.write(str.data(), static_cast<std::streamsize>(str.size()));
+            }
+
+        private:
+            std::ostream& m_os;
+        };
+
+        // Bounds-checked reading of the mapped bytes
+        class Reader
+        {
+        public:
+            explicit Reader(std::span<const std::byte> bytes)
+                : m_bytes(bytes)
+            {
+            }
+
+            template <typename T>
+            T read()
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                T value{};
+                std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+                return value;
+            }
+
+            // Count of the records of minRecordSize bytes at least: checked against the rest, before the records are allocated
+            size_t readCount(size_t minRecordSize)
+            {
+                const auto count = read<std::uint32_t>();
+                if (count > (m_bytes.size() - m_pos) / minRecordSize)
+                    throw std::out_of_range("count out of range: " + std::to_string(count));
+                return count;
+            }
+
+            size_t readId(size_t limit)
+            {
+                const auto id = read<std::uint32_t>();
+                if (id >= limit)
+                    throw std::out_of_range("id out of range: " + std::to_string(id));
+                return id;
+            }
+
+            std::string_view readString()
+            {
+                const auto bytes = take(read<std::uint32_t>());
+                return { reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+            }
+
+            std::span<const std::byte> take(size_t size)
+            {
+                if (size > m_bytes.size() - m_pos)
+                    throw std::out_of_range("truncated");
+                const auto bytes = m_bytes.subspan(m_pos, size);
+                m_pos += size;
+                return bytes;
+            }
+
+            bool atEnd() const { return m_pos == m_bytes.size(); }
+
+        private:
+            std::span<const std::byte> m_bytes;
+            size_t m_pos = 0;
+        };
+
+        class StringTable
+        {
+        public:
+            size_t intern(const std::string& str)
+            {
+                const auto [it, added] = m_ids.try_emplace(str, m_strings.size());
+                if (added)
+                    m_strings.push_back(str);
+                return it->second;
+            }
+            const std::vector<std::string>& strings() const { return m_strings; }
+
+        private:
+            std::unordered_map<std::string, size_t> m_ids;
+            std::vector<std::string> m_strings;
+        };
+
+        void writeAttribute(Writer& writer, const Attribute& attr)
+        {
+            writer.writeId(attr.typeId.value());
+            writer.writeId(attr.valueId.value());
+        }
+
+        void writeComparable(Writer& writer, const std::variant<PersonID, Attribute>& comparable)
+        {
+            if (const auto* person = std::get_if<PersonID>(&comparable))
+            {
+                writer.writeId(person->value());
+                writer.write(noneId);
+            }
+            else
+                writeAttribute(writer, std::get<Attribute>(comparable));
+        }
+
+        void writeConstraint(Writer& writer, const ConstraintModel& constraint)
+        {
+            std::visit(utils::overloaded
+                {
+                    [&writer](const PersonProperty& c)
+                    {
+                        writer.write(ConstraintKind::PersonProperty);
+                        writer.writeId(c.person.value());
+                        writeAttribute(writer, c.attr);
+                        writer.write(static_cast<std::uint8_t>(c.negate));
+                    },
+                    [&writer](const SameOwner& c)
+                    {
+                        writer.write(ConstraintKind::SameOwner);
+                        writeAttribute(writer, c.first);
+                        writeAttribute(writer, c.second);
+                        writer.write(static_cast<std::uint8_t>(c.secondNegate));
+                    },
+                    [&writer](const PositionComparison& c)
+                    {
+                        ENSURE(c.compareByType != identityAxis, "A pivoted model can't be compiled");
+                        writer.write(ConstraintKind::PositionComparison);
+                        writeComparable(writer, c.first);
+                        writeComparable(writer, c.second);
+                        writer.writeId(c.compareByType.value());
+                        writer.write(c.relation);
+                    },
+                }, constraint);
+        }
+
+        // Ids are checked against the definition: a corrupted file must not index out of the tables
+        class ConstraintReader
+        {
+        public:
+            ConstraintReader(Reader& reader, const PuzzleDefinition& definition)
+                : m_reader(reader)
+                , m_definition(definition)
+            {
+            }
+
+            ConstraintModel read()
+            {
+                switch (m_reader.read<ConstraintKind>())
+                {
+                case ConstraintKind::PersonProperty:
+                {
+                    const auto person = PersonID{ m_reader.readId(m_definition.persons.size()) };
+                    const auto attr = readAttribute();
+                    return PersonProperty{ .person = person, .attr = attr, .negate = readBool() };
+                }
+                case ConstraintKind::SameOwner:
+                {
+                    const auto first = readAttribute();
+                    const auto second = readAttribute();
+                    return SameOwner{ .first = first, .second = second, .secondNegate = readBool() };
+                }
+                case ConstraintKind::PositionComparison:
+                {
+                    const auto first = readComparable();
+                    const auto second = readComparable();
+                    const auto compareBy = AttributeTypeID{ m_reader.readId(m_definition.attributes.size()) };
+                    const auto relation = m_reader.read<PuzzleDefinition::Comparison::Relation>();
+                    if (relation == PuzzleDefinition::Comparison::Relation::Uninitialized || relation > PuzzleDefinition::Comparison::Relation::After)
+                        throw std::out_of_range("bad relation");
+                    return PositionComparison{ .first = first, .second = second, .compareByType = compareBy, .relation = relation };
+                }
+                default:
+                    throw std::out_of_range("bad constraint kind");
+                }
+            }
+
+        private:
+            Attribute readAttribute()
+            {
+                const auto typeId = m_reader.readId(m_definition.attributes.size());
+                const auto valueId = m_reader.readId(m_definition.attributes[typeId].values.size());
+                return { .typeId = AttributeTypeID{ typeId }, .valueId = AttributeValueID{ valueId } };
+            }
+
+            std::variant<PersonID, Attribute> readComparable()
+            {
+                const auto first = m_reader.read<std::uint32_t>();
+                const auto second = m_reader.read<std::uint32_t>();
+                if (second == noneId)
+                {
+                    if (first >= m_definition.persons.size())
+                        throw std::out_of_range("person id out of range");
+                    return PersonID{ first };
+                }
+                if (first >= m_definition.attributes.size() || second >= m_definition.attributes[first].values.size())
+                    throw std::out_of_range("attribute id out of range");
+                return Attribute{ .typeId = AttributeTypeID{ first }, .valueId = AttributeValueID{ second } };
+            }
+
+            bool readBool()
+            {
+                return m_reader.read<std::uint8_t>() != 0;
+            }
+
+        private:
+            Reader& m_reader;
+            const PuzzleDefinition& m_definition;
+        };
+
+        // The definition constraint of its indexed form (see PuzzleModel constructor)
+        std::variant<PuzzleDefinition::Fact, PuzzleDefinition::Comparison> toDefinition(const ConstraintModel& constraint, const PuzzleDefinition& definition)
+        {
+            auto attribute = [&definition](const Attribute& attr)
+                {
+                    const auto& description = definition.attributes[attr.typeId.value()];
+                    return PuzzleDefinition::Attribute{ .type = description.type, .value = description.values[attr.valueId.value()] };
+                };
+            auto person = [&definition](PersonID personId)
+                {
+                    return PuzzleDefinition::Attribute{ .type = PuzzleDefinition::personTypeName, .value = definition.persons[personId.value()] };
+                };
+            auto comparable = [attribute, person](const std::variant<PersonID, Attribute>& comp)
+                {
+                    return std::visit(utils::overloaded{ person, attribute }, comp);
+                };
+
+            return std::visit(utils::overloaded
+                {
+                    [&](const PersonProperty& c) -> std::variant<PuzzleDefinition::Fact, PuzzleDefinition::Comparison>
+                    {
+                        return PuzzleDefinition::Fact{ .first = person(c.person), .second = attribute(c.attr), .secondNegate = c.negate };
+                    },
+                    [&](const SameOwner& c) -> std::variant<PuzzleDefinition::Fact, PuzzleDefinition::Comparison>
+                    {
+                        return PuzzleDefinition::Fact{ .first = attribute(c.first), .second = attribute(c.second), .secondNegate = c.secondNegate };
+                    },
+                    [&](const PositionComparison& c) -> std::variant<PuzzleDefinition::Fact, PuzzleDefinition::Comparison>
+                    {
+                        return PuzzleDefinition::Comparison{ .first = comparable(c.first), .second = comparable(c.second),
+                            .compareBy = definition.attributes[c.compareByType.value()].type, .relation = c.relation };
+                    },
+                }, constraint);
+        }
+
+        std::unique_ptr<CompiledPuzzle::Data> readData(std::span<const std::byte> bytes)
+        {
+            Reader reader{ bytes };
+            const auto fileSignature = reader.take(signature.size());
+            if (std::memcmp(fileSignature.data(), signature.data(), signature.size()) != 0)
+                throw std::invalid_argument("not a compiled puzzle");
+            if (reader.read<std::uint32_t>() != version)
+                throw std::invalid_argument("of another version, compile the puzzle again");
+            if (reader.read<std::uint32_t>() != byteOrderMark)
+                throw std::invalid_argument("of another byte order, compile the puzzle again");
+
+            const std::string configText{ reader.readString() };
+            std::vector<std::string_view> strings(reader.readCount(idSize));
+            for (auto& str : strings)
+                str = reader.readString();
+
+            PuzzleDefinition definition;
+            definition.persons.resize(reader.readCount(idSize));
+            for (auto& person : definition.persons)
+                person = strings[reader.readId(strings.size())];
+            definition.attributes.resize(reader.readCount(minAttributeSize));
+            for (auto& attr : definition.attributes)
+            {
+                attr.type = strings[reader.readId(strings.size())];
+                attr.values.resize(reader.readCount(idSize));
+                for (auto& value : attr.values)
+                    value = strings[reader.readId(strings.size())];
+            }
+
+            const auto definitionConstraints = reader.read<std::uint32_t>();
+            std::vector<ConstraintModel> constraints(reader.readCount(minConstraintSize));
+            if (definitionConstraints > constraints.size())
+                throw std::out_of_range("bad constraints count");
+            ConstraintReader constraintReader{ reader, definition };
+            for (auto& constraint : constraints)
+                constraint = constraintReader.read();
+            for (size_t index = 0; index < definitionConstraints; ++index)
+                definition.constraints.push_back(toDefinition(constraints[index], definition));
+
+            // The wheels of the model and of its sub-models (fewer types) and pivoted model (the same count): the permutations of the persons
+            const auto personCount = definition.persons.size();
+            std::map<std::uint64_t, SearchSpace::Wheels> wheels;
+            for (auto wheelSets = reader.readCount(minWheelSetSize); wheelSets > 0; --wheelSets)
+            {
+                const auto key = reader.read<std::uint64_t>();
+                SearchSpace::Wheels odometer(reader.readCount(minWheelSize));
+                if (odometer.size() > definition.attributes.size())
+                    throw std::out_of_range("too many wheels");
+                for (auto& wheel : odometer)
+                {
+                    if (reader.read<std::uint32_t>() != personCount)
+                        throw std::out_of_range("bad permutation size");
+                    wheel.resize(reader.readCount(std::max<size_t>(personCount, 1)));
+                    for (auto& assignment : wheel)
+                    {
+                        std::array<bool, std::numeric_limits<std::uint8_t>::max() + 1> owned{}; // index: person
+                        assignment = AttributeAssignment(personCount);
+                        std::ranges::transform(reader.take(personCount), assignment.begin(), [personCount, &owned](std::byte owner)
+                            {
+                                const auto person = std::to_integer<size_t>(owner);
+                                if (person >= personCount || std::exchange(owned[person], true))
+                                    throw std::out_of_range("not a permutation");
+                                return PersonID{ person };
+                            });
+                    }
+                }
+                wheels.insert_or_assign(key, std::move(odometer));
+            }
+            if (!reader.atEnd())
+                throw std::invalid_argument("unexpected data at the end");
+
+            return std::make_unique<CompiledPuzzle::Data>(CompiledPuzzle::Data{ .configText = configText,
+                .model = PuzzleModel::fromIndexed(std::move(definition), std::move(constraints)), .wheels = std::make_unique<WheelStore>(std::move(wheels)) });
+        }
+
+        std::string configText(const SolverConfig& config)
+        {
+            std::ostringstream text;
+            text << config;
+            return text.str();
+        }
+    }
+
+    CompiledPuzzle CompiledPuzzle::load(const std::filesystem::path& path)
+    {
+        try
+        {
+            const platform::MappedFile file{ path };
+            return CompiledPuzzle{ readData(file.bytes()) };
+        }
+        catch (const std::exception& e)
+        {
+            throw PuzzleSyntaxError("Bad compiled puzzle file '" + path.string() + "': " + e.what());
+        }
+    }
+
+    bool CompiledPuzzle::isCompiledPuzzle(const std::filesystem::path& path)
+    {
+        std::ifstream is(path, std::ios::binary);
+        std::array<char, signature.size()> fileSignature{};
+        return is.read(fileSignature.data(), fileSignature.size()) && fileSignature == signature;
+    }
+
+    CompiledPuzzle::CompiledPuzzle(std::unique_ptr<Data> data)
+        : m_data(std::move(data))
+    {
+    }
+
+    CompiledPuzzle::~CompiledPuzzle() = default;
+    CompiledPuzzle::CompiledPuzzle(CompiledPuzzle&&) noexcept = default;
+    CompiledPuzzle& CompiledPuzzle::operator=(CompiledPuzzle&&) noexcept = default;
+
+    const PuzzleDefinition& CompiledPuzzle::definition() const
+    {
+        return m_data->model.definition();
+    }
+
+    bool CompiledPuzzle::compiledWith(const SolverConfig& config) const
+    {
+        return configText(config) == m_data->configText;
+    }
+
+    bool CompiledPuzzle::hasWheels() const
+    {
+        return !m_data->wheels->wheels().empty();
+    }
+
+    void details::writeCompiledPuzzle(const std::filesystem::path& path, const SolverConfig& config, const PuzzleModel& model, const WheelStore& wheels)
+    {
+        const auto& definition = model.definition();
+        StringTable strings;
+        std::vector<size_t> personIds;
+        std::ranges::transform(definition.persons, std::back_inserter(personIds), [&strings](const auto& name) { return strings.intern(name); });
+        std::vector<std::pair<size_t, std::vector<size_t>>> attributeIds;
+        for (const auto& attr : definition.attributes)
+        {
+            auto& [typeId, valueIds] = attributeIds.emplace_back(strings.intern(attr.type), std::vector<size_t>{});
+            std::ranges::transform(attr.values, std::back_inserter(valueIds), [&strings](const auto& name) { return strings.intern(name); });
+        }
+
+        std::ofstream os(path, std::ios::binary | std::ios::trunc);
+        if (!os)
+            throw std::runtime_error("Can't open the compiled puzzle file: " + path.string());
+        Writer writer{ os };
+        os.write(signature.data(), signature.size());
+        writer.write(version);
+        writer.write(byteOrderMark);
+        writer.writeString(configText(config));
+
+        writer.writeId(strings.strings().size());
+        for (const auto& str : strings.strings())
+            writer.writeString(str);
+        writer.writeId(personIds.size());
+        for (const auto id : personIds)
+            writer.writeId(id);
+        writer.writeId(attributeIds.size());
+        for (const auto& [typeId, valueIds] : attributeIds)
+        {
+            writer.writeId(typeId);
+            writer.writeId(valueIds.size());
+            for (const auto id : valueIds)
+                writer.writeId(id);
+        }
+
+        writer.writeId(definition.constraints.size());
+        writer.writeId(model.constraints().size());
+        for (const auto& constraint : model.constraints())
+            writeConstraint(writer, constraint);
+
+        writer.writeId(wheels.wheels().size());
+        for (const auto& [key, odometer] : wheels.wheels())
+        {
+            writer.write(key);
+            writer.writeId(odometer.size());
+            for (const auto& wheel : odometer)
+            {
+                const size_t size = wheel.empty() ? 0 : wheel.front().size();
+                ENSURE(size <= std::numeric_limits<std::uint8_t>::max() + size_t{ 1 }, "Too many persons to save the wheels: " << size);
+                writer.writeId(size);
+                writer.writeId(wheel.size());
+                for (const auto& assignment : wheel)
+                {
+                    for (const auto personId : assignment)
+                        writer.write(static_cast<std::uint8_t>(personId.value()));
+                }
+            }
+        }
+
+        os.close();
+        if (!os)
+            throw std::runtime_error("Can't write the compiled puzzle file: " + path.string());
+    }
+}
@@ -40,9 +40,12 @@ namespace epuzzle::details
     {
         std::variant<PersonID, Attribute> first;
         std::variant<PersonID, Attribute> second;
-        AttributeTypeID compareByType;
+        AttributeTypeID compareByType; // or identityAxis
         PuzzleDefinition::Comparison::Relation relation;
     };
 
+    // compareByType of a pivoted model (see PuzzleModel::pivot): the position is the person index itself
+    inline constexpr AttributeTypeID identityAxis{ std::numeric_limits<size_t>::max() };
+
     using ConstraintModel = std::variant<PersonProperty, SameOwner, PositionComparison>;
 }
@@ -88,6 +88,168 @@ namespace epuzzle::details
         return m_constraints;
     }
 
+    void PuzzleModel::addConstraints(std::vector<ConstraintModel> constraints)
+    {
+        std::ranges::move(constraints, std::back_inserter(m_constraints));
+    }
+
+    PuzzleModel PuzzleModel::fromIndexed(PuzzleDefinition definition, std::vector<ConstraintModel> constraints)
+    {
+        ENSURE(constraints.size() >= definition.constraints.size(), "The indexed constraints must include the definition ones");
+        return PuzzleModel{ std::move(definition), std::move(constraints) };
+    }
+
+    PuzzleModel::PuzzleModel(PuzzleDefinition definition, std::vector<ConstraintModel> constraints, std::optional<AttributeTypeID> pivotAxis)
+        : m_definition(std::move(definition))
+        , m_constraints(std::move(constraints))
+        , m_pivotAxis(pivotAxis)
+    {
+    }
+
+    std::vector<std::vector<AttributeTypeID>> PuzzleModel::independentComponents() const
+    {
+        // Union-find over attribute types
+        utils::IndexedVector<AttributeTypeID, AttributeTypeID> parent(attrTypeCount());
+        std::iota(parent.begin(), parent.end(), AttributeTypeID{ 0 });
+        auto root = [&parent](AttributeTypeID typeId)
+            {
+                while (parent[typeId] != typeId)
+                    typeId = parent[typeId] = parent[parent[typeId]];
+                return typeId;
+            };
+
+        for (const auto& constraint : m_constraints)
+        {
+            const auto types = involvedAttrTypes(constraint);
+            for (const auto typeId : types)
+                parent[root(typeId)] = root(types.front());
+        }
+
+        // Components are ordered by their minimal type, types inside are ascending
+        constexpr auto absent = std::numeric_limits<size_t>::max();
+        utils::IndexedVector<AttributeTypeID, size_t> componentIndex(std::vector<size_t>(attrTypeCount(), absent)); // index: root
+        std::vector<std::vector<AttributeTypeID>> components;
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ attrTypeCount() }; ++typeId)
+        {
+            auto& index = componentIndex[root(typeId)];
+            if (index == absent)
+            {
+                index = components.size();
+                components.emplace_back();
+            }
+            components[index].push_back(typeId);
+        }
+        return components;
+    }
+
+    PuzzleModel PuzzleModel::subModel(const std::vector<AttributeTypeID>& types) const
+    {
+        constexpr auto absent = std::numeric_limits<size_t>::max();
+        utils::IndexedVector<AttributeTypeID, size_t> newIndex(std::vector<size_t>(attrTypeCount(), absent));
+
+        PuzzleDefinition definition{ .persons = m_definition.persons, .attributes = {}, .constraints = {} };
+        for (const auto typeId : types)
+        {
+            newIndex[typeId] = definition.attributes.size();
+            definition.attributes.push_back(m_definition.attributes[typeId.value()]);
+        }
+
+        auto remap = [&newIndex](AttributeTypeID typeId) { return typeId == identityAxis ? typeId : AttributeTypeID{ newIndex[typeId] }; };
+        auto remapAttr = [remap](Attribute attr) { return Attribute{ .typeId = remap(attr.typeId), .valueId = attr.valueId }; };
+        auto remapComparable = [remapAttr](std::variant<PersonID, Attribute> comparable)
+            {
+                if (auto* attr = std::get_if<Attribute>(&comparable))
+                    *attr = remapAttr(*attr);
+                return comparable;
+            };
+
+        std::vector<ConstraintModel> constraints;
+        for (const auto& constraint : m_constraints)
+        {
+            const auto involved = involvedAttrTypes(constraint);
+            const auto included = std::ranges::count_if(involved, [&newIndex](AttributeTypeID typeId) { return newIndex[typeId] != absent; });
+            if (included == 0)
+                continue;
+            ENSURE(static_cast<size_t>(included) == involved.size(), "Sub-puzzle types must be a union of independent components!");
+
+            constraints.push_back(std::visit(utils::overloaded
+                {
+                    [remapAttr](const PersonProperty& property) -> ConstraintModel
+                    {
+                        return PersonProperty{ property.person, remapAttr(property.attr), property.negate };
+                    },
+                    [remapAttr](const SameOwner& sameOwner) -> ConstraintModel
+                    {
+                        return SameOwner{ remapAttr(sameOwner.first), remapAttr(sameOwner.second), sameOwner.secondNegate };
+                    },
+                    [remap, remapComparable](const PositionComparison& comparison) -> ConstraintModel
+                    {
+                        return PositionComparison{ remapComparable(comparison.first), remapComparable(comparison.second),
+                            remap(comparison.compareByType), comparison.relation };
+                    },
+                }, constraint));
+        }
+        std::optional<AttributeTypeID> pivotAxis;
+        if (m_pivotAxis && newIndex[*m_pivotAxis] != absent)
+            pivotAxis = remap(*m_pivotAxis);
+        return PuzzleModel{ std::move(definition), std::move(constraints), pivotAxis };
+    }
+
+    PuzzleModel PuzzleModel::pivot(AttributeTypeID axis) const
+    {
+        ENSURE(!m_pivotAxis && axis < AttributeTypeID{ attrTypeCount() }, "Unexpected pivot axis: " << axis.value());
+        PuzzleDefinition definition{ .persons = m_definition.attributes[axis.value()].values, .attributes = m_definition.attributes, .constraints = {} };
+        definition.attributes[axis.value()].values = m_definition.persons;
+
+        auto swap = [axis](const std::variant<PersonID, Attribute>& comparable) -> std::variant<PersonID, Attribute>
+            {
+                if (const auto* person = std::get_if<PersonID>(&comparable))
+                    return Attribute{ .typeId = axis, .valueId = AttributeValueID{ person->value() } };
+
+                const auto& attr = std::get<Attribute>(comparable);
+                if (attr.typeId == axis)
+                    return PersonID{ attr.valueId.value() };
+                return attr;
+            };
+        auto fact = [](const std::variant<PersonID, Attribute>& first, const std::variant<PersonID, Attribute>& second, bool negate) -> ConstraintModel
+            {
+                // Two values of the axis are never the same (the definition validation rejects such facts)
+                ENSURE(std::holds_alternative<Attribute>(first) || std::holds_alternative<Attribute>(second), "Unexpected fact on the pivot axis");
+                if (const auto* person = std::get_if<PersonID>(&first))
+                    return PersonProperty{ *person, std::get<Attribute>(second), negate };
+                if (const auto* person = std::get_if<PersonID>(&second))
+                    return PersonProperty{ *person, std::get<Attribute>(first), negate };
+                return SameOwner{ std::get<Attribute>(first), std::get<Attribute>(second), negate };
+            };
+
+        std::vector<ConstraintModel> constraints;
+        constraints.reserve(m_constraints.size());
+        for (const auto& constraint : m_constraints)
+        {
+            constraints.push_back(std::visit(utils::overloaded
+                {
+                    [&swap, &fact](const PersonProperty& property) { return fact(swap(property.person), swap(property.attr), property.negate); },
+                    [&swap, &fact](const SameOwner& sameOwner) { return fact(swap(sameOwner.first), swap(sameOwner.second), sameOwner.secondNegate); },
+                    [&swap, axis](const PositionComparison& comparison) -> ConstraintModel
+                    {
+                        return PositionComparison{ swap(comparison.first), swap(comparison.second),
+                            comparison.compareByType == axis ? identityAxis : comparison.compareByType, comparison.relation };
+                    },
+                }, constraint));
+        }
+        return PuzzleModel{ std::move(definition), std::move(constraints), axis };
+    }
+
+    std::optional<AttributeTypeID> PuzzleModel::pivotAxis() const
+    {
+        return m_pivotAxis;
+    }
+
+    const PuzzleDefinition& PuzzleModel::definition() const
+    {
+        return m_definition;
+    }
+
     std::string_view PuzzleModel::personName(PersonID id) const
     {
         return m_definition.persons[id.value()];
@@ -102,4 +264,129 @@ namespace epuzzle::details
     {
         return m_definition.attributes[typeId.value()].values[valueId.value()];
     }
+
+    std::vector<AttributeTypeID> involvedAttrTypes(const ConstraintModel& constraint)
+    {
+        std::vector<AttributeTypeID> types;
+        auto addComparable = [&types](const std::variant<PersonID, Attribute>& comparable)
+            {
+                if (const auto* attr = std::get_if<Attribute>(&comparable))
+                    types.push_back(attr->typeId);
+            };
+
+        std::visit(utils::overloaded
+            {
+                [&types](const PersonProperty& property) { types.push_back(property.attr.typeId); },
+                [&types](const SameOwner& sameOwner) { types.push_back(sameOwner.first.typeId); types.push_back(sameOwner.second.typeId); },
+                [&types, addComparable](const PositionComparison& comparison)
+                {
+                    addComparable(comparison.first);
+                    addComparable(comparison.second);
+                    if (comparison.compareByType != identityAxis)
+                        types.push_back(comparison.compareByType);
+                },
+            }, constraint);
+
+        std::ranges::sort(types);
+        const auto duplicates = std::ranges::unique(types);
+        types.erase(duplicates.begin(), duplicates.end());
+        return types;
+    }
+
+    std::vector<InterchangeableValues> interchangeableValues(const PuzzleModel& model)
+    {
+        utils::IndexedVector<AttributeTypeID, std::vector<bool>> mentioned(model.attrTypeCount());
+        for (auto& values : mentioned)
+            values.resize(model.personCount(), false);
+
+        auto mention = [&mentioned](const Attribute& attr) { mentioned[attr.typeId][attr.valueId.value()] = true; };
+        for (const auto& constraint : model.constraints())
+        {
+            std::visit(utils::overloaded
+                {
+                    [mention](const PersonProperty& property) { mention(property.attr); },
+                    [mention](const SameOwner& sameOwner) { mention(sameOwner.first); mention(sameOwner.second); },
+                    [&mentioned, mention](const PositionComparison& comparison)
+                    {
+                        for (const auto* comparable : { &comparison.first, &comparison.second })
+                        {
+                            if (const auto* attr = std::get_if<Attribute>(comparable))
+                                mention(*attr);
+                        }
+                        if (comparison.compareByType == identityAxis)
+                            return;
+                        auto& positions = mentioned[comparison.compareByType];
+                        std::fill(positions.begin(), positions.end(), true); // positions are distinguished by their order
+                    },
+                }, constraint);
+        }
+        if (const auto axis = model.pivotAxis())
+            std::fill(mentioned[*axis].begin(), mentioned[*axis].end(), true); // the persons are distinguished (not permuted)
+
+        std::vector<InterchangeableValues> groups;
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ model.attrTypeCount() }; ++typeId)
+        {
+            InterchangeableValues group{ .typeId = typeId, .values = {} };
+            for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ model.personCount() }; ++valueId)
+            {
+                if (!mentioned[typeId][valueId.value()])
+                    group.values.push_back(valueId);
+            }
+            if (group.values.size() >= 2)
+                groups.push_back(std::move(group));
+        }
+        return groups;
+    }
+
+    std::optional<AttributeTypeID> choosePivotAxis(const PuzzleModel& model)
+    {
+        if (model.pivotAxis())
+            return {};
+
+        // Single-type constraints prefilter the wheels (the most effective pruning) - lose none of them,
+        // then the fewer types the multi-type constraints involve, the earlier they are checked.
+        auto cost = [](const std::vector<ConstraintModel>& constraints)
+            {
+                std::pair<std::ptrdiff_t, size_t> total{};
+                for (const auto& constraint : constraints)
+                {
+                    const auto typeCount = involvedAttrTypes(constraint).size();
+                    if (typeCount == 1)
+                        --total.first;
+                    else
+                        total.second += typeCount;
+                }
+                return total;
+            };
+        // Constraints on two values of the axis only are not expressible after the pivot (they are constant anyway)
+        auto pivotable = [&model](AttributeTypeID axis)
+            {
+                auto onAxis = [axis](const std::variant<PersonID, Attribute>& comparable)
+                    {
+                        const auto* attr = std::get_if<Attribute>(&comparable);
+                        return attr && attr->typeId == axis;
+                    };
+                return std::ranges::none_of(model.constraints(), [axis, &onAxis](const ConstraintModel& constraint)
+                    {
+                        if (const auto* sameOwner = std::get_if<SameOwner>(&constraint))
+                            return sameOwner->first.typeId == axis && sameOwner->second.typeId == axis;
+                        const auto* comparison = std::get_if<PositionComparison>(&constraint);
+                        return comparison && comparison->compareByType == axis && onAxis(comparison->first) && onAxis(comparison->second);
+                    });
+            };
+
+        std::optional<AttributeTypeID> bestAxis;
+        auto bestCost = cost(model.constraints());
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ model.attrTypeCount() }; ++typeId)
+        {
+            if (!pivotable(typeId))
+                continue;
+            if (const auto pivotCost = cost(model.pivot(typeId).constraints()); pivotCost < bestCost)
+            {
+                bestCost = pivotCost;
+                bestAxis = typeId;
+            }
+        }
+        return bestAxis;
+    }
 }
@@ -8,17 +8,58 @@ namespace epuzzle::details
     {
     public:
         explicit PuzzleModel(PuzzleDefinition);
+        // Already indexed (e.g. a compiled puzzle): the definition is normalized and validated, the constraints are its constraints
+        // in the same order, followed by the derived ones (see addConstraints). Nothing is looked up.
+        static PuzzleModel fromIndexed(PuzzleDefinition, std::vector<ConstraintModel>);
 
         size_t personCount() const;
         size_t attrTypeCount() const;
         const std::vector<ConstraintModel>& constraints() const;
+        // Append derived constraints (e.g. facts proven by presolve). They must be implied by the original ones.
+        void addConstraints(std::vector<ConstraintModel>);
 
+        // Connected components of the attribute-constraint graph (types are linked if some constraint involves both).
+        // Different components are independent sub-puzzles: the solutions set is their product.
+        std::vector<std::vector<AttributeTypeID>> independentComponents() const;
+        // Sub-puzzle with the given attribute types only (renumbered in the given order) and the constraints on them.
+        // The types must be a union of independent components.
+        PuzzleModel subModel(const std::vector<AttributeTypeID>&) const;
+
+        // The same puzzle with the attribute type as the identity axis: its values become the persons, the persons become
+        // the values of this type (the same id and name). Comparisons by it compare person indexes (see identityAxis).
+        // The solutions are mapped back by swapping the `person` row and the row of this type (see SolutionSet::Pivot).
+        PuzzleModel pivot(AttributeTypeID) const;
+        // Of a pivoted model: the type whose values are the original persons
+        std::optional<AttributeTypeID> pivotAxis() const;
+
+        const PuzzleDefinition& definition() const;
         std::string_view personName(PersonID) const;
         std::string_view attrTypeName(AttributeTypeID) const;
         std::string_view attrValueName(AttributeTypeID, AttributeValueID) const;
 
+    private:
+        PuzzleModel(PuzzleDefinition, std::vector<ConstraintModel>, std::optional<AttributeTypeID> pivotAxis = {});
+
     private:
         const PuzzleDefinition m_definition;
         std::vector<ConstraintModel> m_constraints;
+        std::optional<AttributeTypeID> m_pivotAxis;
     };
+
+    // The pivot axis making the constraints cheapest for bruteforce (usually the type most facts are about): first, the most
+    // single-type constraints (prefiltered into the wheels), then the least sum of the involved types counts of the others.
+    // Empty if no pivot lowers the cost, or the model is pivoted already.
+    std::optional<AttributeTypeID> choosePivotAxis(const PuzzleModel&);
+
+    // Values of one attribute type that no constraint distinguishes: any permutation of their owners maps a solution to a solution.
+    // Such are values no constraint mentions, if the type is not used to compare positions (and is not the pivot axis: persons).
+    struct InterchangeableValues
+    {
+        AttributeTypeID typeId;
+        std::vector<AttributeValueID> values; // ascending, at least 2
+    };
+    std::vector<InterchangeableValues> interchangeableValues(const PuzzleModel&);
+
+    // Attribute types whose assignments can affect the constraint result (unique, ascending).
+    std::vector<AttributeTypeID> involvedAttrTypes(const ConstraintModel&);
 }
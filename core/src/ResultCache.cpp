@@ -0,0 +1,240 @@
+#include "CachedSolver.h"
+
+namespace epuzzle
+{
+namespace
+{
+    using Entry = ResultCache::Data::Entry;
+
+    // Text format, a record per line, the fields are tab-separated:
+    //   epuzzle-result <version>
+    //   form <canonical form>
+    //   count <solutions>
+    //   set <parts> <pivot>            - if kept: the solution set in the canonical form (see CanonicalPuzzle::SolutionSetForm),
+    //   symmetry <groups>                followed by a line per group: the canonical type, then the canonical values, space-separated;
+    //   part <solutions>               - per part, followed by a line per canonical solution:
+    //   <row> <row> ...                - a row per canonical attribute type: the values of the canonical persons, space-separated
+    //                                    (empty if the type is not of the part)
+    constexpr auto header = "epuzzle-result";
+    constexpr int version = 2;
+    constexpr char delim = '\t';
+
+    std::filesystem::path entryPath(const std::filesystem::path& directory, const std::string& hash)
+    {
+        return directory / (hash + ".result");
+    }
+
+    // The empty fields are kept (the empty rows)
+    std::vector<std::string> splitFields(const std::string& line, char separator)
+    {
+        std::vector<std::string> fields;
+        for (size_t begin = 0;;)
+        {
+            const auto end = line.find(separator, begin);
+            fields.push_back(line.substr(begin, end - begin));
+            if (end == std::string::npos)
+                return fields;
+            begin = end + 1;
+        }
+    }
+
+    std::uint64_t toNumber(const std::string& field)
+    {
+        size_t parsed = 0;
+        const auto number = std::stoull(field, &parsed);
+        if (parsed != field.size())
+            throw std::invalid_argument("not a number: " + field);
+        return number;
+    }
+
+    std::vector<std::uint32_t> toNumbers(const std::string& field)
+    {
+        std::vector<std::uint32_t> numbers;
+        if (!field.empty())
+            std::ranges::transform(splitFields(field, ' '), std::back_inserter(numbers), [](const std::string& number) { return static_cast<std::uint32_t>(toNumber(number)); });
+        return numbers;
+    }
+
+    void writeNumbers(std::ostream& os, const std::vector<std::uint32_t>& numbers)
+    {
+        for (size_t index = 0; index < numbers.size(); ++index)
+            os << (index > 0 ? " " : "") << numbers[index];
+    }
+
+    // Empty if there is no file or it is not readable: a cache, the puzzle is solved again
+    std::optional<Entry> readEntry(const std::filesystem::path& path)
+    {
+        std::ifstream is(path);
+        if (!is)
+            return {};
+        try
+        {
+            std::string line;
+            auto fields = [&is, &line](std::string_view key)
+                {
+                    if (!std::getline(is, line))
+                        return std::vector<std::string>{};
+                    auto values = splitFields(line, delim);
+                    if (values.front() != key)
+                        return std::vector<std::string>{};
+                    values.erase(values.begin());
+                    return values;
+                };
+            auto field = [&fields](std::string_view key)
+                {
+                    const auto values = fields(key);
+                    return values.size() == 1 ? values.front() : std::string{};
+                };
+            if (field(header) != std::to_string(version))
+                return {};
+            Entry entry;
+            entry.form = field("form");
+            entry.count = toNumber(field("count"));
+            if (const auto set = fields("set"); set.size() == 2)
+            {
+                auto& solutions = entry.solutions.emplace();
+                solutions.pivot = toNumber(set[1]);
+                for (auto groups = toNumber(field("symmetry")); groups > 0; --groups)
+                {
+                    if (!std::getline(is, line))
+                        return {};
+                    solutions.symmetry.push_back(toNumbers(line));
+                }
+                for (auto parts = toNumber(set[0]); parts > 0; --parts)
+                {
+                    auto& part = solutions.parts.emplace_back();
+                    for (auto count = toNumber(field("part")); count > 0; --count)
+                    {
+                        if (!std::getline(is, line))
+                            return {};
+                        auto& solution = part.emplace_back();
+                        std::ranges::transform(splitFields(line, delim), std::back_inserter(solution), toNumbers);
+                    }
+                }
+            }
+            return entry;
+        }
+        catch (const std::exception&) // bad numbers
+        {
+            return {};
+        }
+    }
+
+    // Atomic replace. Not written - not cached
+    void writeEntry(const std::filesystem::path& path, const Entry& entry)
+    {
+        auto tempPath = path;
+        tempPath += ".tmp";
+        {
+            std::ofstream os(tempPath, std::ios::trunc);
+            os << header << delim << version << "\n";
+            os << "form" << delim << entry.form << "\n";
+            os << "count" << delim << entry.count << "\n";
+            if (entry.solutions)
+            {
+                const auto& solutions = *entry.solutions;
+                os << "set" << delim << solutions.parts.size() << delim << solutions.pivot << "\n";
+                os << "symmetry" << delim << solutions.symmetry.size() << "\n";
+                for (const auto& group : solutions.symmetry)
+                {
+                    writeNumbers(os, group);
+                    os << "\n";
+                }
+                for (const auto& part : solutions.parts)
+                {
+                    os << "part" << delim << part.size() << "\n";
+                    for (const auto& solution : part)
+                    {
+                        for (size_t row = 0; row < solution.size(); ++row)
+                        {
+                            os << (row > 0 ? std::string(1, delim) : std::string{});
+                            writeNumbers(os, solution[row]);
+                        }
+                        os << "\n";
+                    }
+                }
+            }
+            os.flush();
+            if (!os)
+            {
+                os.close();
+                std::error_code ignored;
+                std::filesystem::remove(tempPath, ignored);
+                return;
+            }
+        }
+        std::error_code ignored;
+        std::filesystem::rename(tempPath, path, ignored);
+    }
+} // namespace
+
+    ResultCache::Data::SharedEntry ResultCache::Data::find(const details::CanonicalPuzzle& canonical)
+    {
+        {
+            const std::lock_guard lock{ guard };
+            if (const auto found = entries.find(canonical.hash()); found != entries.end() && found->second->form == canonical.form())
+                return found->second;
+        }
+        if (!directory)
+            return {};
+
+        auto entry = readEntry(entryPath(*directory, canonical.hash()));
+        if (!entry || entry->form != canonical.form())
+            return {};
+        const std::lock_guard lock{ guard };
+        auto& cached = entries[canonical.hash()];
+        if (!cached || cached->form != canonical.form())
+            cached = std::make_shared<const Entry>(std::move(*entry));
+        stats.entries = entries.size();
+        return cached;
+    }
+
+    ResultCache::Data::SharedEntry ResultCache::Data::add(const details::CanonicalPuzzle& canonical, Entry entry)
+    {
+        SharedEntry added;
+        {
+            const std::lock_guard lock{ guard };
+            auto& cached = entries[canonical.hash()];
+            if (cached && cached->form == entry.form && cached->solutions && !entry.solutions)
+                return cached;
+            cached = added = std::make_shared<const Entry>(std::move(entry));
+            stats.entries = entries.size();
+        }
+        if (directory)
+            writeEntry(entryPath(*directory, canonical.hash()), *added);
+        return added;
+    }
+
+    void ResultCache::Data::countLookup(bool hit)
+    {
+        const std::lock_guard lock{ guard };
+        ++(hit ? stats.hits : stats.misses);
+    }
+
+    ResultCache::ResultCache()
+        : m_data(std::make_unique<Data>(std::nullopt))
+    {
+    }
+
+    ResultCache::ResultCache(std::filesystem::path directory)
+    {
+        std::filesystem::create_directories(directory);
+        m_data = std::make_unique<Data>(std::move(directory));
+    }
+
+    ResultCache::~ResultCache() = default;
+
+    ResultCache::Stats ResultCache::stats() const
+    {
+        const std::lock_guard lock{ m_data->guard };
+        return m_data->stats;
+    }
+
+    void ResultCache::clear()
+    {
+        const std::lock_guard lock{ m_data->guard };
+        m_data->entries.clear();
+        m_data->stats = {};
+    }
+
+}
@@ -0,0 +1,203 @@
+#include "epuzzle/SolutionSet.h"
+
+namespace epuzzle
+{
+namespace
+{
+    std::uint64_t checkedMultiply(std::uint64_t lhs, std::uint64_t rhs)
+    {
+        ENSURE(rhs == 0 || lhs <= std::numeric_limits<std::uint64_t>::max() / rhs, "Too much solutions count for using uint64!");
+        return lhs * rhs;
+    }
+
+    std::uint64_t checkedFactorial(std::uint64_t n)
+    {
+        std::uint64_t res = 1;
+        for (std::uint64_t i = 2; i <= n; ++i)
+            res = checkedMultiply(res, i);
+        return res;
+    }
+
+    // Permute the group values among their owners: permutation with the given index (factorial number system)
+    void permuteGroup(PuzzleSolution& solution, const SolutionSet::ValueGroup& group, std::uint64_t permutationIndex)
+    {
+        const auto rowIt = std::ranges::find(solution.attributes, group.type, &PuzzleSolution::Attribute::type);
+        ENSURE(rowIt != solution.attributes.end(), "Unexpected symmetry group type: " << group.type);
+        auto& row = rowIt->values;
+
+        std::vector<size_t> owners; // owners[j] - index of the person owning group.values[j]
+        owners.reserve(group.values.size());
+        for (const auto& value : group.values)
+            owners.push_back(static_cast<size_t>(std::ranges::find(row, value) - row.begin()));
+
+        std::vector<std::string> remaining = group.values;
+        for (size_t j = 0; j < owners.size(); ++j)
+        {
+            const auto radix = utils::factorial(remaining.size() - 1);
+            const auto pick = static_cast<size_t>(permutationIndex / radix);
+            permutationIndex %= radix;
+            row[owners[j]] = std::move(remaining[pick]);
+            remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(pick));
+        }
+    }
+}
+
+    SolutionSet::SolutionSet(std::vector<PuzzleSolution> solutions)
+        : m_classCount(solutions.size())
+    {
+        m_parts.push_back(std::move(solutions));
+    }
+
+    SolutionSet::SolutionSet(std::vector<std::vector<PuzzleSolution>> parts, std::vector<std::string> attributeOrder, std::vector<ValueGroup> symmetry)
+        : m_parts(std::move(parts))
+        , m_attributeOrder(std::move(attributeOrder))
+        , m_symmetry(std::move(symmetry))
+        , m_classCount(m_parts.empty() ? 0 : 1)
+    {
+        for (const auto& part : m_parts)
+            m_classCount = checkedMultiply(m_classCount, part.size());
+        for (const auto& group : m_symmetry)
+            m_multiplicity = checkedMultiply(m_multiplicity, checkedFactorial(group.values.size()));
+        checkedMultiply(m_classCount, m_multiplicity); // size() must fit too
+    }
+
+    std::uint64_t SolutionSet::size() const
+    {
+        return m_classCount * m_multiplicity;
+    }
+
+    bool SolutionSet::empty() const
+    {
+        return m_classCount == 0;
+    }
+
+    std::uint64_t SolutionSet::classCount() const
+    {
+        return m_classCount;
+    }
+
+    std::uint64_t SolutionSet::multiplicity() const
+    {
+        return m_multiplicity;
+    }
+
+    const std::vector<SolutionSet::ValueGroup>& SolutionSet::symmetry() const
+    {
+        return m_symmetry;
+    }
+
+    PuzzleSolution SolutionSet::representative(std::uint64_t classIndex) const
+    {
+        ENSURE(classIndex < m_classCount, "Solution class index is out of range: " << classIndex << ", count: " << m_classCount);
+        return unpivot(combine(classIndex));
+    }
+
+    PuzzleSolution SolutionSet::combine(std::uint64_t classIndex) const
+    {
+        if (m_parts.size() == 1)
+            return m_parts.front()[classIndex];
+
+        PuzzleSolution combined;
+        combined.attributes.reserve(1 + m_attributeOrder.size());
+        for (const auto& part : m_parts)
+        {
+            const auto& partial = part[classIndex % part.size()];
+            classIndex /= part.size();
+            // The first attribute of each part is `person`: take it once
+            const auto skipPerson = combined.attributes.empty() ? 0 : 1;
+            combined.attributes.insert(combined.attributes.end(), partial.attributes.begin() + skipPerson, partial.attributes.end());
+        }
+
+        auto order = [this](const PuzzleSolution::Attribute& attr)
+            {
+                return attr.type == PuzzleSolution::personTypeName ? -1 : std::ranges::find(m_attributeOrder, attr.type) - m_attributeOrder.begin();
+            };
+        std::ranges::stable_sort(combined.attributes, std::less{}, order);
+        return combined;
+    }
+
+    std::vector<PuzzleSolution> SolutionSet::representatives() const
+    {
+        if (m_parts.size() == 1 && !m_pivot)
+            return m_parts.front();
+
+        std::vector<PuzzleSolution> solutions;
+        solutions.reserve(m_classCount);
+        for (std::uint64_t classIndex = 0; classIndex < m_classCount; ++classIndex)
+            solutions.push_back(representative(classIndex));
+        return solutions;
+    }
+
+    PuzzleSolution SolutionSet::operator[](std::uint64_t index) const
+    {
+        ENSURE(index < size(), "Solution index is out of range: " << index << ", size: " << size());
+        auto solution = combine(index / m_multiplicity);
+        auto permutationIndex = index % m_multiplicity;
+        for (const auto& group : m_symmetry)
+        {
+            const auto groupPermutations = utils::factorial(group.values.size());
+            permuteGroup(solution, group, permutationIndex % groupPermutations);
+            permutationIndex /= groupPermutations;
+        }
+        return unpivot(std::move(solution));
+    }
+
+    void SolutionSet::setPivot(Pivot pivot)
+    {
+        m_pivot = std::move(pivot);
+    }
+
+    const std::vector<std::vector<PuzzleSolution>>& SolutionSet::parts() const
+    {
+        return m_parts;
+    }
+
+    const std::optional<SolutionSet::Pivot>& SolutionSet::pivot() const
+    {
+        return m_pivot;
+    }
+
+    PuzzleSolution SolutionSet::unpivot(PuzzleSolution solution) const
+    {
+        if (!m_pivot)
+            return solution;
+
+        auto& rows = solution.attributes;
+        const auto personRow = std::ranges::find(rows, std::string_view(PuzzleSolution::personTypeName), &PuzzleSolution::Attribute::type);
+        const auto axisRow = std::ranges::find(rows, m_pivot->type, &PuzzleSolution::Attribute::type);
+        ENSURE(personRow != rows.end() && axisRow != rows.end(), "Unexpected pivoted solution, axis: " << m_pivot->type);
+        std::swap(personRow->values, axisRow->values);
+
+        // column index -> index of its person
+        std::vector<size_t> columns(personRow->values.size());
+        std::vector<size_t> personIndexes;
+        personIndexes.reserve(columns.size());
+        for (const auto& person : personRow->values)
+            personIndexes.push_back(static_cast<size_t>(std::ranges::find(m_pivot->persons, person) - m_pivot->persons.begin()));
+        std::iota(columns.begin(), columns.end(), size_t{ 0 });
+        std::ranges::sort(columns, std::less{}, [&personIndexes](size_t column) { return personIndexes[column]; });
+
+        for (auto& row : rows)
+        {
+            std::vector<std::string> values;
+            values.reserve(columns.size());
+            for (const auto column : columns)
+                values.push_back(std::move(row.values[column]));
+            row.values = std::move(values);
+        }
+        return solution;
+    }
+
+    std::vector<PuzzleSolution> SolutionSet::toVector() const
+    {
+        if (m_multiplicity == 1)
+            return representatives();
+
+        std::vector<PuzzleSolution> solutions;
+        solutions.reserve(size());
+        for (std::uint64_t index = 0; index < size(); ++index)
+            solutions.push_back((*this)[index]);
+        return solutions;
+    }
+
+}
@@ -1,25 +1,114 @@
 #include "bruteforce/BruteForceFactory.h"
+#include "bruteforce/PivotedSolver.h"
+#include "counting/CountingSolver.h"
 #include "deductive/DeductiveSolver.h"
+#include "join/JoinSolver.h"
+#include "localsearch/LocalSearchSolver.h"
+#include "presolve/Prober.h"
+#include "CachedSolver.h"
+#include "CompiledModel.h"
 
 namespace epuzzle
 {
+namespace
+{
+    using namespace details;
 
-    std::unique_ptr<Solver> Solver::create(SolverConfig config, PuzzleDefinition puzzleDefinition)
+    PuzzleModel prepareModel(const SolverConfig& config, PuzzleDefinition puzzleDefinition)
     {
         validate(config);
 
         normalize(puzzleDefinition);
         validate(puzzleDefinition);
 
-        using namespace details;
         PuzzleModel puzzleModel{ std::move(puzzleDefinition) };
+        if (config.probing)
+        {
+            const bool sequential = config.bruteForce && config.bruteForce->execution == SolverConfig::BruteForceConfig::ExecPolicy::Sequential;
+            presolve::addProbedFacts(puzzleModel, sequential ? 1 : std::max(1u, std::jthread::hardware_concurrency()));
+        }
+        return puzzleModel;
+    }
 
+    // WheelStore (optional): see SolverContext
+    std::unique_ptr<Solver> createPreparedSolver(const SolverConfig& config, PuzzleModel&& puzzleModel, bruteforce::WheelStore* wheelStore)
+    {
         if (config.solvingMethod == SolverConfig::SolvingMethod::Deductive)
         {
             return std::make_unique<deductive::DeductiveSolver>(std::move(puzzleModel));
         }
 
-        return bruteforce::createSolver(config.bruteForce.value(), std::move(puzzleModel));
+        if (config.solvingMethod == SolverConfig::SolvingMethod::LocalSearch)
+        {
+            return std::make_unique<localsearch::LocalSearchSolver>(config.localSearch.value(), std::move(puzzleModel));
+        }
+
+        if (config.solvingMethod == SolverConfig::SolvingMethod::Counting)
+        {
+            return std::make_unique<counting::CountingSolver>(std::move(puzzleModel));
+        }
+
+        // Wheels methods: a compared-by attribute type may be a better fixed axis than the persons
+        auto createWheelsSolver = [&config, wheelStore](PuzzleModel&& model) -> std::unique_ptr<Solver>
+            {
+                if (config.solvingMethod == SolverConfig::SolvingMethod::RelationalJoin)
+                    return std::make_unique<join::JoinSolver>(bruteforce::SolverContext{ std::move(model), config.bruteForce.value(), wheelStore });
+                return bruteforce::createSolver(config.bruteForce.value(), std::move(model), wheelStore);
+            };
+
+        if (const auto axis = config.bruteForce->pivot ? choosePivotAxis(puzzleModel) : std::nullopt)
+        {
+            SolutionSet::Pivot pivot{ .type = std::string(puzzleModel.attrTypeName(*axis)), .persons = {} };
+            for (auto personId = PersonID{ 0 }; personId < PersonID{ puzzleModel.personCount() }; ++personId)
+                pivot.persons.emplace_back(puzzleModel.personName(personId));
+            return std::make_unique<bruteforce::PivotedSolver>(createWheelsSolver(puzzleModel.pivot(*axis)), std::move(pivot));
+        }
+        return createWheelsSolver(std::move(puzzleModel));
+    }
+} // namespace
+
+    std::unique_ptr<Solver> Solver::create(SolverConfig config, PuzzleDefinition puzzleDefinition)
+    {
+        return createPreparedSolver(config, prepareModel(config, std::move(puzzleDefinition)), nullptr);
+    }
+
+    std::unique_ptr<Solver> Solver::create(SolverConfig config, const CompiledPuzzle& compiledPuzzle)
+    {
+        validate(config); // a matching config may come from a corrupted file as well
+        if (!compiledPuzzle.compiledWith(config))
+            return create(std::move(config), compiledPuzzle.definition()); // prepared for another config
+
+        const auto& compiled = compiledPuzzle.data();
+        return createPreparedSolver(config, PuzzleModel{ compiled.model }, compiled.wheels.get());
+    }
+
+    std::unique_ptr<Solver> Solver::create(SolverConfig config, PuzzleDefinition puzzleDefinition, ResultCache& resultCache)
+    {
+        using Method = SolverConfig::SolvingMethod;
+        if (config.solvingMethod != Method::BruteForce && config.solvingMethod != Method::Counting && config.solvingMethod != Method::RelationalJoin)
+            return create(std::move(config), std::move(puzzleDefinition)); // not exhaustive: no result to cache
+
+        validate(config);
+        normalize(puzzleDefinition);
+        validate(puzzleDefinition);
+        CanonicalPuzzle canonical{ puzzleDefinition };
+        auto cached = resultCache.data().find(canonical);
+        auto createSolver = [config, definition = std::move(puzzleDefinition)]
+            {
+                return createPreparedSolver(config, prepareModel(config, definition), nullptr);
+            };
+        return std::make_unique<CachedSolver>(resultCache.data(), std::move(canonical), std::move(cached), std::move(createSolver));
+    }
+
+    void compilePuzzle(SolverConfig config, PuzzleDefinition puzzleDefinition, const std::filesystem::path& path, bool withWheels)
+    {
+        const auto puzzleModel = prepareModel(config, std::move(puzzleDefinition));
+        bruteforce::WheelStore wheels; // recording
+        const bool wheelsMethod = config.solvingMethod == SolverConfig::SolvingMethod::BruteForce
+            || config.solvingMethod == SolverConfig::SolvingMethod::RelationalJoin;
+        if (withWheels && wheelsMethod)
+            createPreparedSolver(config, PuzzleModel{ puzzleModel }, &wheels); // the contexts generate their wheels
+        writeCompiledPuzzle(path, config, puzzleModel, wheels);
     }
 
 }
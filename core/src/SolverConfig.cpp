@@ -11,20 +11,32 @@ namespace epuzzle
     {
         using Method = SolverConfig::SolvingMethod;
         using ExecPolicy = SolverConfig::BruteForceConfig::ExecPolicy;
+        using WheelOrder = SolverConfig::BruteForceConfig::WheelOrder;
     }
 
     void validate(const SolverConfig& cfg)
     {
-        if (cfg.solvingMethod == Method::BruteForce)
+        if (cfg.solvingMethod == Method::BruteForce || cfg.solvingMethod == Method::RelationalJoin)
         {
-            ENSURE_CFG(cfg.bruteForce.has_value(), "Must present for BruteForce solving method!");
+            ENSURE_CFG(cfg.bruteForce.has_value(), "Must present for BruteForce and RelationalJoin solving methods!");
             const auto execPolicy = cfg.bruteForce->execution;
             ENSURE_CFG(execPolicy == ExecPolicy::Parallel || execPolicy == ExecPolicy::Sequential,
                 "Unexpected execution policy: (int)" << static_cast<int>(execPolicy));
+            const auto wheelOrder = cfg.bruteForce->wheelOrder;
+            ENSURE_CFG(wheelOrder == WheelOrder::Lexicographic || wheelOrder == WheelOrder::MinimalChange,
+                "Unexpected wheel order: (int)" << static_cast<int>(wheelOrder));
+        }
+        else if (cfg.solvingMethod == Method::LocalSearch)
+        {
+            ENSURE_CFG(cfg.localSearch.has_value(), "Must present for LocalSearch solving method!");
+            ENSURE_CFG(cfg.localSearch->timeBudget.count() > 0, "Time budget must be positive!");
+            const auto walkProbability = cfg.localSearch->randomWalkProbability;
+            ENSURE_CFG(0.0 <= walkProbability && walkProbability <= 1.0, "Unexpected random walk probability: " << walkProbability);
         }
         else
         {
-            ENSURE_CFG(cfg.solvingMethod == Method::Deductive, "Unexpected solving method: (int)" << static_cast<int>(cfg.solvingMethod));
+            ENSURE_CFG(cfg.solvingMethod == Method::Deductive || cfg.solvingMethod == Method::Counting,
+                "Unexpected solving method: (int)" << static_cast<int>(cfg.solvingMethod));
         }
     }
 
@@ -36,6 +48,9 @@ namespace epuzzle
             {
             case Method::Deductive:     return os << "Deductive";
             case Method::BruteForce:    return os << "BruteForce";
+            case Method::LocalSearch:   return os << "LocalSearch";
+            case Method::Counting:      return os << "Counting";
+            case Method::RelationalJoin: return os << "RelationalJoin";
             default: ENSURE(false, "Unsupported solving method type: (int) " << static_cast<int>(method));
             };
         }
@@ -49,6 +64,16 @@ namespace epuzzle
             default: ENSURE(false, "Unsupported execution policy type: (int) " << static_cast<int>(exec));
             };
         }
+
+        std::ostream& operator<<(std::ostream& os, WheelOrder order)
+        {
+            switch (order)
+            {
+            case WheelOrder::Lexicographic: return os << "Lexicographic";
+            case WheelOrder::MinimalChange: return os << "MinimalChange";
+            default: ENSURE(false, "Unsupported wheel order type: (int) " << static_cast<int>(order));
+            };
+        }
     }
 
     std::ostream& operator<<(std::ostream& os, const SolverConfig& cfg)
@@ -57,8 +82,18 @@ namespace epuzzle
         if (cfg.bruteForce)
         {
             const auto& bf = cfg.bruteForce.value();
-            os << ", prefilter = " << (bf.prefilter ? "true" : "false") << ", execution = " << bf.execution;
+            os << ", prefilter = " << (bf.prefilter ? "true" : "false") << ", presolve = " << (bf.presolve ? "true" : "false")
+                << ", decompose = " << (bf.decompose ? "true" : "false") << ", breakSymmetry = " << (bf.breakSymmetry ? "true" : "false")
+                << ", meetInTheMiddle = " << (bf.meetInTheMiddle ? "true" : "false") << ", pivot = " << (bf.pivot ? "true" : "false")
+                << ", execution = " << bf.execution << ", wheelOrder = " << bf.wheelOrder;
+        }
+        if (cfg.localSearch)
+        {
+            const auto& ls = cfg.localSearch.value();
+            os << ", seed = " << ls.seed << ", timeBudget = " << ls.timeBudget.count() << "ms, tabuTenure = " << ls.tabuTenure
+                << ", randomWalkProbability = " << ls.randomWalkProbability;
         }
+        os << ", probing = " << (cfg.probing ? "true" : "false");
         return os;
     }
 
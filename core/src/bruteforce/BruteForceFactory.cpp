@@ -1,12 +1,41 @@
 #include "SequentialSolver.h"
 #include "ParallelSolver.h"
+#include "DecomposedSolver.h"
+#include "MeetInMiddleSolver.h"
 #include "BruteForceFactory.h"
 
 namespace epuzzle::details::bruteforce
 {
-    std::unique_ptr<Solver> createSolver(const SolverConfig::BruteForceConfig& config, PuzzleModel&& puzzleModel)
+    std::unique_ptr<Solver> createSolver(const SolverConfig::BruteForceConfig& config, PuzzleModel&& puzzleModel, WheelStore* wheelStore)
     {
-        SolverContext context{ std::move(puzzleModel), config.prefilter };
+        if (config.decompose)
+        {
+            const auto components = puzzleModel.independentComponents();
+            if (components.size() > 1)
+            {
+                auto partConfig = config;
+                partConfig.decompose = false;
+                std::vector<std::unique_ptr<Solver>> parts;
+                parts.reserve(components.size());
+                for (const auto& component : components)
+                    parts.push_back(createSolver(partConfig, puzzleModel.subModel(component), wheelStore));
+
+                std::vector<std::string> attributeOrder;
+                for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ puzzleModel.attrTypeCount() }; ++typeId)
+                    attributeOrder.emplace_back(puzzleModel.attrTypeName(typeId));
+
+                return std::make_unique<DecomposedSolver>(std::move(parts), std::move(attributeOrder));
+            }
+        }
+
+        const bool meetInTheMiddle = config.meetInTheMiddle && puzzleModel.attrTypeCount() >= 2;
+        SolverContext context{ std::move(puzzleModel), config, wheelStore };
+
+        if (meetInTheMiddle)
+        {
+            const bool parallel = config.execution == SolverConfig::BruteForceConfig::ExecPolicy::Parallel;
+            return std::make_unique<MeetInMiddleSolver>(std::move(context), parallel ? std::jthread::hardware_concurrency() : 1);
+        }
 
         if (config.execution == SolverConfig::BruteForceConfig::ExecPolicy::Sequential)
         {
@@ -1,8 +1,10 @@
 #pragma once
 #include "epuzzle/Solver.h"
 #include "PuzzleModel.h"
+#include "WheelStore.h"
 
 namespace epuzzle::details::bruteforce
 {
-    std::unique_ptr<Solver> createSolver(const SolverConfig::BruteForceConfig&, PuzzleModel&&);
+    // WheelStore (optional): see SolverContext
+    std::unique_ptr<Solver> createSolver(const SolverConfig::BruteForceConfig&, PuzzleModel&&, WheelStore* = nullptr);
 }
@@ -0,0 +1,262 @@
+#include "epuzzle/Exceptions.h"
+#include "Checkpoint.h"
+#include "utils/platform/FileSync.h"
+
+namespace epuzzle::details::bruteforce
+{
+    namespace
+    {
+        // Text format, a record per line, the fields are tab-separated:
+        //   epuzzle-checkpoint <version>
+        //   fingerprint <hex>
+        //   total <candidates>
+        //   done <offset> <count>              - for each processed range
+        //   solution <rows>                    - for each solution, followed by its rows:
+        //   <attribute type> <value> <value> ...
+        constexpr auto header = "epuzzle-checkpoint";
+        constexpr int version = 1;
+        constexpr char delim = '\t';
+
+        std::vector<std::string> splitFields(const std::string& line)
+        {
+            std::vector<std::string> fields;
+            std::istringstream is(line);
+            for (std::string field; std::getline(is, field, delim);)
+                fields.push_back(std::move(field));
+            return fields;
+        }
+
+        std::uint64_t toNumber(const std::string& field)
+        {
+            size_t parsed = 0;
+            const auto number = std::stoull(field, &parsed);
+            if (parsed != field.size())
+                throw std::invalid_argument("not a number: " + field);
+            return number;
+        }
+
+        bool isWritable(std::string_view name)
+        {
+            return name.find_first_of("\t\r\n") == std::string_view::npos;
+        }
+    }
+
+    std::uint64_t Checkpoint::State::doneCount() const
+    {
+        return std::accumulate(done.begin(), done.end(), std::uint64_t{ 0 }, [](std::uint64_t sum, const SpaceSplitter::Chunk& chunk) { return sum + chunk.count; });
+    }
+
+    void Checkpoint::State::markDone(SpaceSplitter::Chunk chunk)
+    {
+        if (chunk.count == 0)
+            return;
+        // Merge with the adjacent ranges: the workers process chunks in about the same order, so the list stays short
+        auto next = std::ranges::lower_bound(done, chunk.offset, std::less{}, &SpaceSplitter::Chunk::offset);
+        ENSURE(next == done.end() || chunk.offset + chunk.count <= next->offset, "The checkpoint range is done twice: " << chunk.offset);
+        if (next != done.end() && chunk.offset + chunk.count == next->offset)
+        {
+            chunk.count += next->count;
+            next = done.erase(next);
+        }
+        if (next != done.begin())
+        {
+            auto& prev = *std::prev(next);
+            ENSURE(prev.offset + prev.count <= chunk.offset, "The checkpoint range is done twice: " << chunk.offset);
+            if (prev.offset + prev.count == chunk.offset)
+            {
+                prev.count += chunk.count;
+                return;
+            }
+        }
+        done.insert(next, chunk);
+    }
+
+    std::optional<Checkpoint::File> Checkpoint::read(const std::filesystem::path& path)
+    {
+        std::ifstream is(path);
+        if (!is)
+            return {};
+
+        auto fail = [&path](const std::string& reason)
+            {
+                return SolverConfigError("Bad checkpoint file '" + path.string() + "': " + reason);
+            };
+        File file;
+        try
+        {
+            std::string line;
+            auto field = [&is, &line](std::string_view key)
+                {
+                    const auto fields = std::getline(is, line) ? splitFields(line) : std::vector<std::string>{};
+                    return (fields.size() == 2 && fields[0] == key) ? fields[1] : std::string{};
+                };
+            if (field(header) != std::to_string(version))
+                throw fail("not a checkpoint file (or of another version)");
+            file.fingerprint = std::stoull(field("fingerprint"), nullptr, 16);
+            file.totalCandidates = toNumber(field("total"));
+
+            while (std::getline(is, line))
+            {
+                const auto fields = splitFields(line);
+                if (fields.size() == 3 && fields[0] == "done")
+                {
+                    const SpaceSplitter::Chunk chunk{ .offset = toNumber(fields[1]), .count = toNumber(fields[2]) };
+                    if (chunk.offset + chunk.count > file.totalCandidates)
+                        throw fail("range out of the search space");
+                    file.state.markDone(chunk);
+                }
+                else if (fields.size() == 2 && fields[0] == "solution")
+                {
+                    auto& solution = file.state.solutions.emplace_back();
+                    for (auto rows = toNumber(fields[1]); rows > 0; --rows)
+                    {
+                        if (!std::getline(is, line))
+                            throw fail("truncated solution");
+                        auto rowFields = splitFields(line);
+                        if (rowFields.empty())
+                            throw fail("empty solution row");
+                        auto& row = solution.attributes.emplace_back(std::move(rowFields.front()), std::vector<std::string>{});
+                        std::move(std::next(rowFields.begin()), rowFields.end(), std::back_inserter(row.values));
+                    }
+                }
+                else
+                    throw fail("unexpected line: " + line);
+            }
+        }
+        catch (const SolverConfigError&)
+        {
+            throw;
+        }
+        catch (const std::exception& e) // bad numbers, overlapping ranges
+        {
+            throw fail(e.what());
+        }
+        return file;
+    }
+
+    void Checkpoint::write(const std::filesystem::path& path, const File& file)
+    {
+        auto tempPath = path;
+        tempPath += ".tmp";
+        {
+            std::ofstream os(tempPath, std::ios::trunc);
+            os << header << delim << version << "\n";
+            os << "fingerprint" << delim << std::hex << file.fingerprint << std::dec << "\n";
+            os << "total" << delim << file.totalCandidates << "\n";
+            for (const auto& chunk : file.state.done)
+                os << "done" << delim << chunk.offset << delim << chunk.count << "\n";
+            for (const auto& solution : file.state.solutions)
+            {
+                os << "solution" << delim << solution.attributes.size() << "\n";
+                for (const auto& row : solution.attributes)
+                {
+                    os << row.type;
+                    for (const auto& value : row.values)
+                        os << delim << value;
+                    os << "\n";
+                }
+            }
+            os.flush();
+            if (!os)
+                throw std::runtime_error("Can't write the checkpoint file: " + tempPath.string());
+        }
+        // On the disk before the rename: after a crash the checkpoint is either the previous or the new one, never truncated
+        platform::syncFile(tempPath);
+        std::filesystem::rename(tempPath, path); // atomic replace
+        platform::syncDirectory(path.parent_path());
+    }
+
+    Checkpoint::State Checkpoint::load(const std::filesystem::path& path, std::uint64_t fingerprint, std::uint64_t totalCandidates)
+    {
+        auto file = read(path);
+        if (!file)
+            return {}; // nothing to resume
+        if (file->fingerprint != fingerprint || file->totalCandidates != totalCandidates)
+            throw SolverConfigError("Can't resume from the checkpoint file '" + path.string() + "': it is of another puzzle or solver config");
+        return std::move(file->state);
+    }
+
+    Checkpoint::Checkpoint(std::filesystem::path path, std::uint64_t fingerprint, std::uint64_t totalCandidates, State state,
+        std::chrono::milliseconds interval)
+        : m_path(std::move(path))
+        , m_fingerprint(fingerprint)
+        , m_totalCandidates(totalCandidates)
+        , m_interval(interval)
+        , m_state(std::move(state))
+        , m_writer([this](std::stop_token st) { runWriter(st); })
+    {
+    }
+
+    Checkpoint::~Checkpoint()
+    {
+        m_writer.request_stop();
+        m_writer.join();
+        try
+        {
+            flush();
+        }
+        catch (const std::exception&) // the previous checkpoint stays valid
+        {
+        }
+    }
+
+    void Checkpoint::commit(SpaceSplitter::Chunk chunk, std::vector<PuzzleSolution> foundInChunk)
+    {
+        for (const auto& solution : foundInChunk)
+        {
+            for (const auto& row : solution.attributes)
+            {
+                ENSURE(isWritable(row.type) && std::ranges::all_of(row.values, isWritable),
+                    "Names with tabs or line breaks can't be checkpointed: " << row.type);
+            }
+        }
+
+        const std::lock_guard lock(m_stateGuard);
+        m_state.markDone(chunk);
+        std::ranges::move(foundInChunk, std::back_inserter(m_state.solutions));
+        m_dirty = true;
+    }
+
+    void Checkpoint::flush()
+    {
+        const std::lock_guard fileLock(m_fileGuard);
+        State snapshot;
+        {
+            const std::lock_guard lock(m_stateGuard);
+            if (!m_dirty)
+                return;
+            snapshot = m_state; // the workers wait for a copy only, not for the file
+            m_dirty = false;
+        }
+
+        try
+        {
+            write(m_path, File{ .fingerprint = m_fingerprint, .totalCandidates = m_totalCandidates, .state = std::move(snapshot) });
+        }
+        catch (const std::exception&)
+        {
+            const std::lock_guard lock(m_stateGuard);
+            m_dirty = true;
+            throw;
+        }
+    }
+
+    // background
+    void Checkpoint::runWriter(std::stop_token st)
+    {
+        std::mutex waitGuard;
+        std::unique_lock waitLock(waitGuard);
+        std::condition_variable_any wakeup;
+        while (!wakeup.wait_for(waitLock, st, m_interval, [] { return false; }) && !st.stop_requested())
+        {
+            try
+            {
+                flush();
+            }
+            catch (const std::exception&) // e.g. disk full: retry next time, the previous checkpoint stays valid
+            {
+            }
+        }
+    }
+
+}
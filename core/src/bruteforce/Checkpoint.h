@@ -0,0 +1,62 @@
+#pragma once
+#include "epuzzle/PuzzleSolution.h"
+#include "SpaceSplitter.h"
+
+namespace epuzzle::details::bruteforce
+{
+
+    // Progress of a long search saved to a file: the fully processed candidate ranges and the solutions found in them.
+    // Workers commit each finished chunk under a short lock (no I/O); a background thread writes the file periodically
+    // to a temporary file and renames it, so the file always holds a consistent state even if the process is killed.
+    // The fingerprint binds the file to the search space (see SolverContext::fingerprint): other searches reject it.
+    class Checkpoint
+    {
+    public:
+        struct State
+        {
+            std::vector<SpaceSplitter::Chunk> done; // sorted, merged
+            std::vector<PuzzleSolution> solutions; // found in the done ranges
+
+            std::uint64_t doneCount() const;
+            void markDone(SpaceSplitter::Chunk);
+        };
+
+        // Empty state if there is no file. Throw SolverConfigError if the file is of another search or corrupted.
+        static State load(const std::filesystem::path&, std::uint64_t fingerprint, std::uint64_t totalCandidates);
+
+        // Raw file access (e.g. merging of the shard results): empty if there is no file, throw SolverConfigError if corrupted
+        struct File
+        {
+            std::uint64_t fingerprint = 0;
+            std::uint64_t totalCandidates = 0;
+            State state;
+        };
+        static std::optional<File> read(const std::filesystem::path&);
+        static void write(const std::filesystem::path&, const File&); // atomic replace
+
+        Checkpoint(std::filesystem::path, std::uint64_t fingerprint, std::uint64_t totalCandidates, State, std::chrono::milliseconds interval);
+        ~Checkpoint(); // the final state is written
+        Checkpoint(const Checkpoint&) = delete;
+        Checkpoint& operator=(const Checkpoint&) = delete;
+
+        // parallel
+        void commit(SpaceSplitter::Chunk, std::vector<PuzzleSolution> foundInChunk);
+        void flush();
+
+    private:
+        void runWriter(std::stop_token);
+
+    private:
+        const std::filesystem::path m_path;
+        const std::uint64_t m_fingerprint;
+        const std::uint64_t m_totalCandidates;
+        const std::chrono::milliseconds m_interval;
+
+        std::mutex m_stateGuard;
+        State m_state;
+        bool m_dirty = true;
+        std::mutex m_fileGuard; // the writer thread and flush()
+        std::jthread m_writer; // the last: stopped and joined first
+    };
+
+}
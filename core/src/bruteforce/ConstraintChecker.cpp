@@ -1,9 +1,17 @@
+#include "epuzzle/ConstexprSolver.h"
 #include "ConstraintChecker.h"
 
 namespace epuzzle::details::bruteforce
 {
 namespace
 {
+    using ct::details::relationHolds;
+
+    // PositionComparison by identityAxis (a pivoted model): the positions are the person indexes, no lookup
+    struct IdentityComparison : PositionComparison
+    {
+    };
+
     // Using if constexpr + static_assert so the compiler helps us find unhandled constraint types at build time.
     template <typename TParams>
     class CheckerImpl final : public ConstraintChecker
@@ -19,6 +27,7 @@ namespace
             if		constexpr (std::is_same_v<TParams, PersonProperty>)     return 1;
             else if constexpr (std::is_same_v<TParams, SameOwner>)          return 2;
             else if constexpr (std::is_same_v<TParams, PositionComparison>) return 4;
+            else if constexpr (std::is_same_v<TParams, IdentityComparison>) return 3;
             else static_assert(false, "Need return complexity value for current TParams!");
         }
 
@@ -46,19 +55,67 @@ namespace
                         return solutionCandidate.ownerOf(attribute->typeId, attribute->valueId);
                     };
 
-                const size_t pos1 = solutionCandidate.personPosition(getPersonByVariant(m_params.first), m_params.compareByType);
-                const size_t pos2 = solutionCandidate.personPosition(getPersonByVariant(m_params.second), m_params.compareByType);
+                const auto pos1 = static_cast<std::ptrdiff_t>(solutionCandidate.personPosition(getPersonByVariant(m_params.first), m_params.compareByType));
+                const auto pos2 = static_cast<std::ptrdiff_t>(solutionCandidate.personPosition(getPersonByVariant(m_params.second), m_params.compareByType));
+                return relationHolds(m_params.relation, pos1, pos2);
+            }
+            else if constexpr (std::is_same_v<TParams, IdentityComparison>)
+            {
+                auto position = [&solutionCandidate](const std::variant<PersonID, Attribute>& personVariant)
+                    {
+                        if (const auto* personId = std::get_if<PersonID>(&personVariant))
+                            return static_cast<std::ptrdiff_t>(personId->value());
 
-                using Relation = decltype(m_params.relation);
-                switch (m_params.relation)
-                {
-                case Relation::ImmediateLeft:   return pos1 < pos2 && (pos2 - pos1 == 1);
-                case Relation::ImmediateRight:  return pos1 > pos2 && (pos1 - pos2 == 1);
-                case Relation::Adjacent:        return std::max(pos1, pos2) - std::min(pos1, pos2) == 1;
-                case Relation::Before:          return pos1 < pos2;
-                case Relation::After:           return pos1 > pos2;
-                default: ENSURE(false, "Unexpected PositionComparison::relation: (int)" << static_cast<int>(m_params.relation));
-                };
+                        const auto& attribute = std::get<Attribute>(personVariant);
+                        return static_cast<std::ptrdiff_t>(solutionCandidate.ownerOf(attribute.typeId, attribute.valueId).value());
+                    };
+                return relationHolds(m_params.relation, position(m_params.first), position(m_params.second));
+            }
+            else
+                static_assert(false, "Need special implementation in satisfiedBy() method for current TParams!");
+        }
+
+        bool satisfiedBy(const PackedAssignment* solutionCandidate) const override
+        {
+            // Hot path: nibble extracts from the words, no virtual calls
+            if constexpr (std::is_same_v<TParams, PersonProperty>)
+            {
+                return (m_params.person == packedOwner(solutionCandidate[m_params.attr.typeId.value()], m_params.attr.valueId))
+                    != m_params.negate;
+            }
+            else if constexpr (std::is_same_v<TParams, SameOwner>)
+            {
+                return (packedOwner(solutionCandidate[m_params.first.typeId.value()], m_params.first.valueId)
+                    == packedOwner(solutionCandidate[m_params.second.typeId.value()], m_params.second.valueId))
+                    != m_params.secondNegate;
+            }
+            else if constexpr (std::is_same_v<TParams, PositionComparison>)
+            {
+                auto getPersonByVariant = [solutionCandidate](const std::variant<PersonID, Attribute>& personVariant) -> PersonID
+                    {
+                        if (const auto* personId = std::get_if<PersonID>(&personVariant))
+                            return *personId;
+
+                        const auto* attribute = std::get_if<Attribute>(&personVariant);
+                        return packedOwner(solutionCandidate[attribute->typeId.value()], attribute->valueId);
+                    };
+
+                const auto positions = solutionCandidate[m_params.compareByType.value()];
+                const auto pos1 = static_cast<std::ptrdiff_t>(packedPosition(positions, getPersonByVariant(m_params.first)));
+                const auto pos2 = static_cast<std::ptrdiff_t>(packedPosition(positions, getPersonByVariant(m_params.second)));
+                return relationHolds(m_params.relation, pos1, pos2);
+            }
+            else if constexpr (std::is_same_v<TParams, IdentityComparison>)
+            {
+                auto position = [solutionCandidate](const std::variant<PersonID, Attribute>& personVariant)
+                    {
+                        if (const auto* personId = std::get_if<PersonID>(&personVariant))
+                            return static_cast<std::ptrdiff_t>(personId->value());
+
+                        const auto* attribute = std::get_if<Attribute>(&personVariant);
+                        return static_cast<std::ptrdiff_t>(packedOwner(solutionCandidate[attribute->typeId.value()], attribute->valueId).value());
+                    };
+                return relationHolds(m_params.relation, position(m_params.first), position(m_params.second));
             }
             else
                 static_assert(false, "Need special implementation in satisfiedBy() method for current TParams!");
@@ -77,6 +134,11 @@ namespace
             [](const auto& arg) -> std::unique_ptr<ConstraintChecker>
             {
                 using T = std::decay_t<decltype(arg)>;
+                if constexpr (std::is_same_v<T, PositionComparison>)
+                {
+                    if (arg.compareByType == identityAxis)
+                        return std::make_unique<CheckerImpl<IdentityComparison>>(IdentityComparison{ arg });
+                }
                 return std::make_unique<CheckerImpl<T>>(arg);
             },
             constraint);
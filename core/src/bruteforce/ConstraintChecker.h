@@ -12,6 +12,8 @@ namespace epuzzle::details::bruteforce
 
         virtual size_t complexity() const = 0;
         virtual bool satisfiedBy(const SearchSpaceCursor& solutionCandidate) const = 0;
+        // The same on the packed candidate (see SearchSpaceCursor::packedCandidate), index: AttributeTypeID
+        virtual bool satisfiedBy(const PackedAssignment* solutionCandidate) const = 0;
     };
 
 }
@@ -0,0 +1,73 @@
+#include "DecomposedSolver.h"
+
+namespace epuzzle::details::bruteforce
+{
+
+    DecomposedSolver::DecomposedSolver(std::vector<std::unique_ptr<Solver>> parts, std::vector<std::string> attributeOrder)
+        : m_parts(std::move(parts))
+        , m_attributeOrder(std::move(attributeOrder))
+    {
+    }
+
+    std::vector<PuzzleSolution> DecomposedSolver::solve(const SolveOptions& opts)
+    {
+        return solveSet(opts).toVector();
+    }
+
+    SolutionSet DecomposedSolver::solveSet(const SolveOptions& opts)
+    {
+        // Overall progress: each part takes an equal share
+        constexpr std::uint64_t partShare = 1'000'000;
+        const std::uint64_t total = partShare * m_parts.size();
+
+        std::vector<std::vector<PuzzleSolution>> partSolutions; // canonical ones
+        std::vector<SolutionSet::ValueGroup> symmetry;
+        partSolutions.reserve(m_parts.size());
+        bool userCanceled = false;
+        for (size_t partIndex = 0; partIndex < m_parts.size() && !userCanceled; ++partIndex)
+        {
+            // Each part checkpoints to its own file (the search spaces differ)
+            auto partCheckpointFile = opts.checkpointFile;
+            if (!partCheckpointFile.empty())
+                partCheckpointFile += ".part" + std::to_string(partIndex + 1);
+            const SolveOptions partOpts{ .progressInterval = opts.progressInterval,
+                .progressCallback = [&opts, &userCanceled, total, partIndex](std::uint64_t partTotal, std::uint64_t partCurrent)
+                {
+                    const auto partDone = static_cast<double>(partCurrent) / static_cast<double>(std::max<std::uint64_t>(1, partTotal));
+                    const auto current = partShare * partIndex + static_cast<std::uint64_t>(partDone * partShare);
+                    userCanceled = !opts.progressCallback(total, current);
+                    return !userCanceled;
+                },
+                .checkpointFile = std::move(partCheckpointFile), .checkpointInterval = opts.checkpointInterval, .resume = opts.resume,
+                .shard = opts.shard };
+            const auto partSet = m_parts[partIndex]->solveSet(partOpts);
+            partSolutions.push_back(partSet.representatives());
+            std::ranges::copy(partSet.symmetry(), std::back_inserter(symmetry));
+
+            if (partSolutions.back().empty()) // the whole puzzle has no solutions
+                break;
+        }
+
+        if (userCanceled)
+            return {};
+
+        opts.progressCallback(total, total);
+        if (partSolutions.size() < m_parts.size())
+            return {};
+
+        return SolutionSet{ std::move(partSolutions), m_attributeOrder, std::move(symmetry) };
+    }
+
+    Solver::Statistics DecomposedSolver::statistics() const
+    {
+        Statistics stats;
+        stats.emplace_back("Independent parts", std::to_string(m_parts.size()));
+        for (size_t partIndex = 0; partIndex < m_parts.size(); ++partIndex)
+        {
+            for (auto& [name, value] : m_parts[partIndex]->statistics())
+                stats.emplace_back("Part " + std::to_string(partIndex + 1) + ": " + name, std::move(value));
+        }
+        return stats;
+    }
+
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "epuzzle/Solver.h"
+
+namespace epuzzle::details::bruteforce
+{
+
+    // Solves independent sub-puzzles (see PuzzleModel::independentComponents) one by one and returns the product of their solutions.
+    // Runtime is the sum of the parts costs instead of their product; the product is counted instantly and enumerated lazily.
+    class DecomposedSolver final : public Solver
+    {
+    public:
+        // attributeOrder - attribute type names of the whole puzzle (order of the combined solutions)
+        DecomposedSolver(std::vector<std::unique_ptr<Solver>> parts, std::vector<std::string> attributeOrder);
+
+        std::vector<PuzzleSolution> solve(const SolveOptions&) override;
+        SolutionSet solveSet(const SolveOptions&) override;
+        Statistics statistics() const override;
+
+    private:
+        const std::vector<std::unique_ptr<Solver>> m_parts;
+        const std::vector<std::string> m_attributeOrder;
+    };
+
+}
@@ -0,0 +1,293 @@
+#include "SpaceSplitter.h"
+#include "MeetInMiddleSolver.h"
+
+namespace epuzzle::details::bruteforce
+{
+namespace
+{
+    constexpr std::uint64_t progressCountInterval = 1'000'000;
+
+    // -------------------------------- class PairView ------------------------------------------------
+
+    // Pair of partial rows (one per half) as a full solution candidate, for the constraint checkers.
+    class PairView final : public SearchSpaceCursor
+    {
+    public:
+        PairView(size_t personCount, size_t attrTypeCount)
+            : m_personCount(personCount)
+            , m_owners(attrTypeCount)
+        {
+        }
+
+        // Owners of the half types values, in the PartialRows layout
+        void setRow(const std::vector<AttributeTypeID>& types, const PersonID* row)
+        {
+            for (const auto typeId : types)
+            {
+                m_owners[typeId] = row;
+                row += m_personCount;
+            }
+        }
+
+        bool moveNext() override
+        {
+            return false; // the rows are set by setRow() only
+        }
+
+        PersonID ownerOf(AttributeTypeID typeId, AttributeValueID valueId) const override
+        {
+            return m_owners[typeId][valueId.value()];
+        }
+
+        size_t personPosition(PersonID personId, AttributeTypeID typeId) const override
+        {
+            return std::find(m_owners[typeId], m_owners[typeId] + m_personCount, personId) - m_owners[typeId];
+        }
+
+        SolutionModel getSolutionModel() const override
+        {
+            SolutionModel solution{ m_owners.size() };
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ m_owners.size() }; ++typeId)
+                solution.setAttributeAssignment(typeId, AttributeAssignment{ std::vector<PersonID>(m_owners[typeId], m_owners[typeId] + m_personCount) });
+            return solution;
+        }
+
+    private:
+        const size_t m_personCount;
+        utils::IndexedVector<AttributeTypeID, const PersonID*> m_owners;
+    };
+
+    // Split of the attribute types into two halves (bit N - AttributeTypeID{N} belongs to the half 1).
+    // Cost: enumeration of both halves + the join, where each cross-half SameOwner key divides the pairs count by personCount.
+    std::uint64_t chooseSplit(const PuzzleModel& model, const SearchSpace& space)
+    {
+        const auto attrTypeCount = model.attrTypeCount();
+        ENSURE(attrTypeCount >= 2 && attrTypeCount < 32, "Unsupported attribute types count for meet-in-the-middle: " << attrTypeCount);
+
+        std::vector<std::pair<AttributeTypeID, AttributeTypeID>> equiLinks;
+        for (const auto& constraint : model.constraints())
+        {
+            if (const auto* sameOwner = std::get_if<SameOwner>(&constraint); sameOwner && !sameOwner->secondNegate)
+                equiLinks.emplace_back(sameOwner->first.typeId, sameOwner->second.typeId);
+        }
+
+        auto inHalf1 = [](std::uint64_t mask, AttributeTypeID typeId) { return ((mask >> typeId.value()) & 1) != 0; };
+        std::uint64_t bestMask = 0;
+        double bestCost = std::numeric_limits<double>::infinity();
+        // The type 0 is always in the half 0: each split is seen once
+        for (std::uint64_t mask = 2; mask < (std::uint64_t{ 1 } << attrTypeCount); mask += 2)
+        {
+            std::array<double, 2> candidates{ 1.0, 1.0 };
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ attrTypeCount }; ++typeId)
+                candidates[inHalf1(mask, typeId)] *= static_cast<double>(space.wheelSize(typeId));
+
+            const auto keys = std::ranges::count_if(equiLinks, [&inHalf1, mask](const auto& link)
+                { return inHalf1(mask, link.first) != inHalf1(mask, link.second); });
+            const double pairs = candidates[0] * candidates[1] / std::pow(static_cast<double>(model.personCount()), static_cast<double>(keys));
+            const double cost = candidates[0] + candidates[1] + pairs;
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestMask = mask;
+            }
+        }
+        return bestMask;
+    }
+
+    std::string typeNames(const PuzzleModel& model, const std::vector<AttributeTypeID>& types)
+    {
+        std::string names;
+        for (const auto typeId : types)
+            names += (names.empty() ? "'" : ", '") + std::string(model.attrTypeName(typeId)) + "'";
+        return names;
+    }
+
+} // namespace
+
+    MeetInMiddleSolver::MeetInMiddleSolver(SolverContext&& ctx, size_t threadCount)
+        : m_ctx(std::move(ctx))
+        , m_threadCount(std::max<size_t>(threadCount, 1))
+    {
+        const auto& model = m_ctx.puzzleModel();
+        const auto splitMask = chooseSplit(model, m_ctx.searchSpace());
+        std::vector<size_t> halfOf(model.attrTypeCount());
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ model.attrTypeCount() }; ++typeId)
+        {
+            halfOf[typeId.value()] = (splitMask >> typeId.value()) & 1;
+            m_halves[halfOf[typeId.value()]].types.push_back(typeId);
+        }
+        for (auto& half : m_halves)
+            half.space = m_ctx.searchSpace().project(half.types);
+
+        // The composite join key (base personCount number) must fit into uint64, extra keys become filters
+        const auto personCount = model.personCount();
+        const size_t maxKeys = static_cast<size_t>(64.0 / std::log2(static_cast<double>(std::max<size_t>(personCount, 2))));
+
+        const auto& constraints = model.constraints();
+        for (size_t constrIndex = 0; constrIndex < constraints.size(); ++constrIndex)
+        {
+            m_checkers.push_back(ConstraintChecker::create(constraints[constrIndex]));
+
+            const auto types = involvedAttrTypes(constraints[constrIndex]);
+            const auto half = halfOf[types.front().value()];
+            if (std::ranges::all_of(types, [&halfOf, half](AttributeTypeID typeId) { return halfOf[typeId.value()] == half; }))
+            {
+                m_halves[half].constraints.push_back(constrIndex);
+                m_halves[half].lowestWheels.push_back(types.front());
+                continue;
+            }
+
+            const auto* sameOwner = std::get_if<SameOwner>(&constraints[constrIndex]);
+            if (sameOwner && !sameOwner->secondNegate && m_joinKeys.size() < maxKeys)
+                m_joinKeys.push_back(halfOf[sameOwner->first.typeId.value()] == 0 ? *sameOwner : SameOwner{ sameOwner->second, sameOwner->first });
+            else
+                m_crossFilters.push_back(constrIndex);
+        }
+    }
+
+    std::vector<PuzzleSolution> MeetInMiddleSolver::search(const SolveOptions& opts) const
+    {
+        const auto& model = m_ctx.puzzleModel();
+        const std::uint64_t total = m_halves[0].space->totalSolutionCandidates() + m_halves[1].space->totalSolutionCandidates();
+        opts.progressCallback(total, 0);
+
+        // 1. Enumerate the halves
+        utils::AtomicProgressTracker atomicTracker{ progressCountInterval };
+        std::array<PartialRows, 2> rows{ PartialRows{ platform::largePages() }, PartialRows{ platform::largePages() } };
+        for (size_t halfIndex = 0; halfIndex < m_halves.size(); ++halfIndex)
+        {
+            const auto& half = m_halves[halfIndex];
+            if (half.space->totalSolutionCandidates() == 0)
+            {
+                opts.progressCallback(total, total);
+                return {};
+            }
+
+            SpaceSplitter spaceSplitter{ half.space->totalSolutionCandidates() };
+            utils::ParallelExecutor<PartialRows> executor{ m_threadCount, [this, &half, &atomicTracker, &spaceSplitter](std::stop_token st)
+                {
+                    return enumerate(half, st, atomicTracker, spaceSplitter);
+                } };
+
+            bool userCanceled = false;
+            while (!executor.waitFor(opts.progressInterval))
+            {
+                if (!opts.progressCallback(total, atomicTracker.load())) [[unlikely]]
+                {
+                    userCanceled = true;
+                    executor.request_stop();
+                    break;
+                }
+            }
+            rows[halfIndex] = utils::join(executor.collectResults());
+            if (userCanceled)
+                return {};
+        }
+
+        // 2. Join: index the half 0 by the key, probe with the half 1
+        const auto personCount = model.personCount();
+        auto joinKey = [this, personCount](const PairView& view, bool probe)
+            {
+                std::uint64_t key = 0;
+                for (const auto& joinKey : m_joinKeys)
+                {
+                    const auto& value = probe ? joinKey.second : joinKey.first;
+                    key = key * personCount + view.ownerOf(value.typeId, value.valueId).value();
+                }
+                return key;
+            };
+
+        PairView view{ personCount, model.attrTypeCount() };
+        std::array<size_t, 2> strides{};
+        for (size_t halfIndex = 0; halfIndex < m_halves.size(); ++halfIndex)
+            strides[halfIndex] = m_halves[halfIndex].types.size() * personCount;
+
+        std::unordered_map<std::uint64_t, std::vector<size_t>> index; // key -> row offsets of the half 0
+        for (size_t offset = 0; offset < rows[0].size(); offset += strides[0])
+        {
+            view.setRow(m_halves[0].types, rows[0].data() + offset);
+            index[joinKey(view, false)].push_back(offset);
+        }
+
+        std::vector<PuzzleSolution> solutions;
+        auto lastProgressTime = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset < rows[1].size(); offset += strides[1])
+        {
+            view.setRow(m_halves[1].types, rows[1].data() + offset);
+            const auto found = index.find(joinKey(view, true));
+            if (found == index.end())
+                continue;
+
+            for (const auto matchedOffset : found->second)
+            {
+                view.setRow(m_halves[0].types, rows[0].data() + matchedOffset);
+                if (std::ranges::all_of(m_crossFilters, [this, &view](size_t constrIndex) { return m_checkers[constrIndex]->satisfiedBy(view); }))
+                    solutions.push_back(view.getSolutionModel().toPuzzleSolution(model));
+            }
+
+            if (std::chrono::steady_clock::now() - lastProgressTime >= opts.progressInterval) [[unlikely]]
+            {
+                lastProgressTime = std::chrono::steady_clock::now();
+                if (!opts.progressCallback(total, atomicTracker.load())) // user canceled
+                    return {};
+            }
+        }
+
+        opts.progressCallback(total, total);
+        return solutions;
+    }
+
+    // parallel
+    MeetInMiddleSolver::PartialRows MeetInMiddleSolver::enumerate(const Half& half, std::stop_token st,
+        utils::AtomicProgressTracker& atomicTracker, SpaceSplitter& spaceSplitter) const
+    {
+        PartialRows threadResult{ platform::largePages() };
+        auto localTracker = atomicTracker.getLocalTracker();
+        const auto personCount = m_ctx.puzzleModel().personCount();
+
+        while (auto chunk = spaceSplitter.nextChunk())
+        {
+            auto cursor = half.space->createCursor(chunk->offset, chunk->count);
+            ENSURE(cursor, "cursor must be created!");
+
+            if (st.stop_requested()) [[unlikely]]
+                return threadResult;
+            do
+            {
+                // Hot cycle!
+                const auto* packed = cursor->packedCandidate();
+                const auto failed = std::ranges::find_if(half.constraints, [this, &cursor, packed](size_t constrIndex)
+                    { return !(packed ? m_checkers[constrIndex]->satisfiedBy(packed) : m_checkers[constrIndex]->satisfiedBy(*cursor)); });
+                if (failed != half.constraints.end()) [[likely]]
+                {
+                    localTracker.update(cursor->skipTo(half.lowestWheels[failed - half.constraints.begin()]));
+                }
+                else
+                {
+                    for (const auto typeId : half.types)
+                    {
+                        for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ personCount }; ++valueId)
+                            threadResult.push_back(cursor->ownerOf(typeId, valueId));
+                    }
+                }
+                localTracker.update();
+            } while (cursor->moveNext());
+        }
+        return threadResult;
+    }
+
+    Solver::Statistics MeetInMiddleSolver::statistics() const
+    {
+        auto stats = m_ctx.statistics();
+        const auto& model = m_ctx.puzzleModel();
+        for (size_t halfIndex = 0; halfIndex < m_halves.size(); ++halfIndex)
+        {
+            const auto& half = m_halves[halfIndex];
+            stats.emplace_back("Half " + std::to_string(halfIndex + 1), typeNames(model, half.types) + ": "
+                + std::to_string(half.space->totalSolutionCandidates()) + " candidates, " + std::to_string(half.constraints.size()) + " constraints");
+        }
+        stats.emplace_back("Cross-half constraints", std::to_string(m_joinKeys.size()) + " join keys, " + std::to_string(m_crossFilters.size()) + " filters");
+        return stats;
+    }
+
+}
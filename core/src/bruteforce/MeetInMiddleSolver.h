@@ -0,0 +1,45 @@
+#pragma once
+#include "epuzzle/Solver.h"
+#include "SolverContext.h"
+
+namespace epuzzle::details::bruteforce
+{
+
+    // Meet-in-the-middle exhaustive search: the wheels are split into two halves linked by few constraints.
+    // Each half's valid partial combinations are enumerated separately (in a thread pool, by the SearchSpace cursors),
+    // then the halves are joined: the first one is indexed by the owners of the cross-half SameOwner values (join key),
+    // the second one probes the index, other cross-half constraints filter the matched pairs.
+    // Cost: about sqrt(total candidates) for a balanced split instead of total.
+    class MeetInMiddleSolver final : public Solver
+    {
+    public:
+        MeetInMiddleSolver(SolverContext&&, size_t threadCount);
+
+        std::vector<PuzzleSolution> solve(const SolveOptions& opts) override { return solveSet(opts).toVector(); }
+        SolutionSet solveSet(const SolveOptions& opts) override { return m_ctx.makeSolutionSet(search(opts)); }
+        Statistics statistics() const override;
+
+    private:
+        struct Half
+        {
+            std::vector<AttributeTypeID> types;
+            std::unique_ptr<SearchSpace> space; // projection of the full space on the types
+            std::vector<size_t> constraints; // indexes of the constraints checked inside the half
+            std::vector<AttributeTypeID> lowestWheels; // of the constraints, for SearchSpaceCursor::skipTo
+        };
+        // Valid partial combinations of a half: owners of all values of the half types, row by row (on huge pages, randomly probed)
+        using PartialRows = std::pmr::vector<PersonID>;
+
+        std::vector<PuzzleSolution> search(const SolveOptions&) const;
+        PartialRows enumerate(const Half&, std::stop_token, utils::AtomicProgressTracker&, class SpaceSplitter&) const;
+
+    private:
+        const SolverContext m_ctx;
+        const size_t m_threadCount;
+        std::vector<std::unique_ptr<ConstraintChecker>> m_checkers; // index: constraint
+        std::array<Half, 2> m_halves;
+        std::vector<SameOwner> m_joinKeys; // first - value of the half 0, second - of the half 1
+        std::vector<size_t> m_crossFilters; // other cross-half constraints
+    };
+
+}
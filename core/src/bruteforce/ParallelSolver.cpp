@@ -1,4 +1,4 @@
-#include "SpaceSplitter.h"
+#include "epuzzle/Exceptions.h"
 #include "ParallelSolver.h"
 
 namespace epuzzle::details::bruteforce
@@ -15,25 +15,54 @@ namespace epuzzle::details::bruteforce
     {
     }
 
-    std::vector<PuzzleSolution> ParallelSolver::solve(const SolveOptions& opts)
+    std::vector<PuzzleSolution> ParallelSolver::search(const SolveOptions& opts) const
     {
-        if (m_totalSolutionCandidates == 0)
+        const auto range = shardRange(opts);
+
+        // Resumed: the done ranges are skipped, their solutions are taken from the checkpoint
+        std::optional<Checkpoint> checkpoint;
+        Checkpoint::State resumed;
+        if (!opts.checkpointFile.empty())
+        {
+            const auto fingerprint = m_ctx.fingerprint();
+            if (opts.resume)
+                resumed = Checkpoint::load(opts.checkpointFile, fingerprint, m_totalSolutionCandidates);
+            if (!std::ranges::all_of(resumed.done, [&range](const SpaceSplitter::Chunk& done)
+                { return range.offset <= done.offset && done.offset + done.count <= range.offset + range.count; }))
+            {
+                throw SolverConfigError("Can't resume from the checkpoint file '" + opts.checkpointFile.string() + "': it is of another shard");
+            }
+            checkpoint.emplace(opts.checkpointFile, fingerprint, m_totalSolutionCandidates, resumed, opts.checkpointInterval);
+        }
+        if (range.count == 0)
             return handleNoSolutionCandidates(opts);
 
-        sendProgress(opts, 0);
+        const auto doneCount = resumed.doneCount();
+        std::vector<std::vector<PuzzleSolution>> results;
+        results.push_back(std::move(resumed.solutions));
+
+        sendProgress(opts, range.count, doneCount);
+
+        // Out of the shard - as if done
+        auto skipped = std::move(resumed.done);
+        if (range.offset > 0)
+            skipped.insert(skipped.begin(), SpaceSplitter::Chunk{ .offset = 0, .count = range.offset });
+        if (const auto rangeEnd = range.offset + range.count; rangeEnd < m_totalSolutionCandidates)
+            skipped.push_back(SpaceSplitter::Chunk{ .offset = rangeEnd, .count = m_totalSolutionCandidates - rangeEnd });
 
         utils::AtomicProgressTracker atomicTracker{ progressCountInterval };
-        SpaceSplitter spaceSplitter{ m_totalSolutionCandidates };
+        SpaceSplitter spaceSplitter{ m_totalSolutionCandidates, SpaceSplitter::defaultChunkSize, std::move(skipped) };
 
-        utils::ParallelExecutor<std::vector<PuzzleSolution>> executor{ threadsCount, [this, &atomicTracker, &spaceSplitter](std::stop_token st)
+        utils::ParallelExecutor<std::vector<PuzzleSolution>> executor{ threadsCount,
+            [this, &atomicTracker, &spaceSplitter, checkpointPtr = checkpoint ? &*checkpoint : nullptr](std::stop_token st)
             {
-                return runWorker(st, atomicTracker, spaceSplitter);
+                return runWorker(st, atomicTracker, spaceSplitter, checkpointPtr);
             } };
 
         bool userCanceled = false;
         while (!executor.waitFor(opts.progressInterval))
         {
-            if (!sendProgress(opts, atomicTracker.load())) [[unlikely]]
+            if (!sendProgress(opts, range.count, doneCount + atomicTracker.load())) [[unlikely]]
             {
                 userCanceled = true;
                 executor.request_stop();
@@ -41,20 +70,49 @@ namespace epuzzle::details::bruteforce
             }
         }
 
-        const auto joinedResult = utils::join(executor.collectResults()); // here all worker-threads finished
+        std::ranges::move(executor.collectResults(), std::back_inserter(results)); // here all worker-threads finished
+        auto joinedResult = utils::join(std::move(results));
 
         if (!userCanceled)
-            handleProgressFinish(opts, atomicTracker.load());
+            handleProgressFinish(opts, range.count, doneCount + atomicTracker.load());
 
         return joinedResult;
     }
 
+    // The boundaries are multiples of the product of the lowest wheels: the largest one still giving each shard a step.
+    // So a shard is a set of whole states of the higher wheels, the cursors of different shards never share a wheel state.
+    SpaceSplitter::Chunk ParallelSolver::shardRange(const SolveOptions& opts) const
+    {
+        if (!opts.shard)
+            return { .offset = 0, .count = m_totalSolutionCandidates };
+
+        const auto [index, count] = *opts.shard;
+        if (count == 0 || index >= count)
+            throw SolverConfigError("Unexpected shard: " + std::to_string(index + 1) + " of " + std::to_string(count));
+
+        const auto& space = m_ctx.searchSpace();
+        std::uint64_t step = 1;
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ m_ctx.puzzleModel().attrTypeCount() }; ++typeId)
+        {
+            const auto nextStep = step * space.wheelSize(typeId);
+            if (nextStep == 0 || m_totalSolutionCandidates / nextStep < count)
+                break;
+            step = nextStep;
+        }
+        // Balanced: the first (steps % count) shards get one step more
+        const auto steps = m_totalSolutionCandidates / step;
+        auto begin = [steps, count](size_t shardIndex) { return (steps / count) * shardIndex + std::min<std::uint64_t>(shardIndex, steps % count); };
+        return { .offset = begin(index) * step, .count = (begin(index + 1) - begin(index)) * step };
+    }
+
     // parallel
-    std::vector<PuzzleSolution> ParallelSolver::runWorker(std::stop_token st, utils::AtomicProgressTracker& atomicTracker, SpaceSplitter& spaceSplitter) const 
+    std::vector<PuzzleSolution> ParallelSolver::runWorker(std::stop_token st, utils::AtomicProgressTracker& atomicTracker, SpaceSplitter& spaceSplitter,
+        Checkpoint* checkpoint) const
     {
         std::vector<PuzzleSolution> threadResult;
         auto localTracker = atomicTracker.getLocalTracker();
         const auto& validator = m_ctx.validator();
+        auto validatorCache = validator.createCache();
 
         while (auto chunk = spaceSplitter.nextChunk())
         {
@@ -63,15 +121,24 @@ namespace epuzzle::details::bruteforce
 
             if (st.stop_requested()) [[unlikely]]
                 return threadResult;
+            validator.rerank(validatorCache); // by the previous chunks of the thread
+            const auto chunkFirstSolution = threadResult.size();
             do
             {
                 // Hot cycle!
-                if (validator.isSolutionValid(*cursor)) [[unlikely]]
+                if (const auto failedWheel = validator.failedWheel(*cursor, validatorCache)) [[likely]]
+                {
+                    localTracker.update(cursor->skipTo(*failedWheel));
+                }
+                else
                 {
                     threadResult.push_back(cursor->getSolutionModel().toPuzzleSolution(m_ctx.puzzleModel()));
                 }
                 localTracker.update();
             } while (cursor->moveNext());
+
+            if (checkpoint) // the chunk is done completely (it isn't interrupted by a stop request)
+                checkpoint->commit(*chunk, { threadResult.begin() + static_cast<std::ptrdiff_t>(chunkFirstSolution), threadResult.end() });
         }
         return threadResult;
     }
@@ -83,16 +150,16 @@ namespace epuzzle::details::bruteforce
         return {};
     }
 
-    bool ParallelSolver::sendProgress(const SolveOptions& opts, std::uint64_t current) const
+    bool ParallelSolver::sendProgress(const SolveOptions& opts, std::uint64_t total, std::uint64_t current) const
     {
-        return opts.progressCallback(m_totalSolutionCandidates, current);
+        return opts.progressCallback(total, current);
     }
 
-    void ParallelSolver::handleProgressFinish(const SolveOptions& opts, std::uint64_t checked) const
+    void ParallelSolver::handleProgressFinish(const SolveOptions& opts, std::uint64_t total, std::uint64_t checked) const
     {
-        sendProgress(opts, checked);
-        ENSURE(checked == m_totalSolutionCandidates, "All workers are finished but progress is not completed!"
-            << " checked: " << checked << ", total: " << m_totalSolutionCandidates);
+        sendProgress(opts, total, checked);
+        ENSURE(checked == total, "All workers are finished but progress is not completed!"
+            << " checked: " << checked << ", total: " << total);
     }
 
 }
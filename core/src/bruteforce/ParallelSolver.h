@@ -1,24 +1,31 @@
 #pragma once
 #include "epuzzle/Solver.h"
+#include "Checkpoint.h"
 #include "SolverContext.h"
 
 namespace epuzzle::details::bruteforce
 {
 
     // Performs parallel exhaustive search in a thread pool using chunked range processing.
+    // Optionally checkpoints the processed chunks to a file and resumes from it (see Checkpoint, SolveOptions::checkpointFile),
+    // searches one shard of the space only (SolveOptions::shard).
     class ParallelSolver final : public Solver
     {
     public:
         explicit ParallelSolver(SolverContext&&);
 
-        std::vector<PuzzleSolution> solve(const SolveOptions&) override;
+        std::vector<PuzzleSolution> solve(const SolveOptions& opts) override { return solveSet(opts).toVector(); }
+        SolutionSet solveSet(const SolveOptions& opts) override { return m_ctx.makeSolutionSet(search(opts)); }
+        Statistics statistics() const override { return m_ctx.statistics(); }
 
     private:
-        std::vector<PuzzleSolution> runWorker(std::stop_token, utils::AtomicProgressTracker&, class SpaceSplitter&) const;
+        std::vector<PuzzleSolution> search(const SolveOptions&) const; // canonical solutions (see SolverContext::makeSolutionSet)
+        std::vector<PuzzleSolution> runWorker(std::stop_token, utils::AtomicProgressTracker&, SpaceSplitter&, Checkpoint*) const;
 
         std::vector<PuzzleSolution> handleNoSolutionCandidates(const SolveOptions&) const;
-        bool sendProgress(const SolveOptions&, std::uint64_t current) const;
-        void handleProgressFinish(const SolveOptions&, std::uint64_t checked) const;
+        bool sendProgress(const SolveOptions&, std::uint64_t total, std::uint64_t current) const;
+        void handleProgressFinish(const SolveOptions&, std::uint64_t total, std::uint64_t checked) const;
+        SpaceSplitter::Chunk shardRange(const SolveOptions&) const; // the whole search space if not sharded
 
     private:
         const SolverContext m_ctx;
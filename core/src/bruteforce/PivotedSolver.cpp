@@ -0,0 +1,27 @@
+#include "PivotedSolver.h"
+
+namespace epuzzle::details::bruteforce
+{
+
+    PivotedSolver::PivotedSolver(std::unique_ptr<Solver> pivoted, SolutionSet::Pivot pivot)
+        : m_pivoted(std::move(pivoted))
+        , m_pivot(std::move(pivot))
+    {
+    }
+
+    SolutionSet PivotedSolver::solveSet(const SolveOptions& opts)
+    {
+        auto solutions = m_pivoted->solveSet(opts);
+        solutions.setPivot(m_pivot);
+        return solutions;
+    }
+
+    Solver::Statistics PivotedSolver::statistics() const
+    {
+        Statistics stats;
+        stats.emplace_back("Pivot axis", "'" + m_pivot.type + "' (its values are the fixed axis, the persons are a wheel)");
+        std::ranges::move(m_pivoted->statistics(), std::back_inserter(stats));
+        return stats;
+    }
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include "epuzzle/Solver.h"
+
+namespace epuzzle::details::bruteforce
+{
+
+    // Solves the pivoted puzzle (see PuzzleModel::pivot) and maps its solutions back to the original persons.
+    class PivotedSolver final : public Solver
+    {
+    public:
+        PivotedSolver(std::unique_ptr<Solver> pivoted, SolutionSet::Pivot);
+
+        std::vector<PuzzleSolution> solve(const SolveOptions& opts) override { return solveSet(opts).toVector(); }
+        SolutionSet solveSet(const SolveOptions&) override;
+        Statistics statistics() const override;
+
+    private:
+        const std::unique_ptr<Solver> m_pivoted;
+        const SolutionSet::Pivot m_pivot;
+    };
+
+}
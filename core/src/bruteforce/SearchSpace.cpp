@@ -50,17 +50,32 @@ namespace
 {
     // Store set of possible permutations for each attribute type
     // Index: AttributeTypeID -> Value: list of possible permutations of values ​​for this attribute
-    using Odometer = utils::IndexedVector<AttributeTypeID, std::vector<AttributeAssignment>>;
+    using Odometer = SearchSpace::Wheels;
+    // The wheels of a search space: shared with other search spaces (see WheelCache), immutable
+    using SharedWheels = utils::IndexedVector<AttributeTypeID, SharedWheel>;
+    // The permutations of the shared wheels, for the cursors
+    using OdometerView = utils::IndexedVector<AttributeTypeID, std::span<const AttributeAssignment>>;
+    // Values of the first wheel whose owners differ from the previous permutation (bit N - AttributeValueID{N}). Index: wheel position
+    using ValueDiffs = std::pmr::vector<std::uint64_t>;
+    // The same permutations packed (see PackedAssignment), empty if persons count > maxPackedPersons.
+    // The hot tables of the workers: on huge pages (see platform::LargePageResource, Wheel::packed), as ValueDiffs.
+    using PackedOdometer = utils::IndexedVector<AttributeTypeID, std::span<const PackedAssignment>>;
 
     // -------------------------------- class CursorImpl ------------------------------------------------
 
     // Implements iteration over a set of combinations in a search space using odometer logic.
+    // Packed: the cursor also keeps the current candidate as packed words (see PackedAssignment), the checkers read them
+    // without virtual calls and permutation lookups.
+    template <bool Packed>
     class CursorImpl final : public SearchSpaceCursor
     {
     public:
-        CursorImpl(const Odometer& odometer, std::uint64_t offset, std::uint64_t count)
+        CursorImpl(const OdometerView& odometer, const PackedOdometer& packedOdometer, const ValueDiffs& firstWheelDiffs, std::uint64_t offset, std::uint64_t count)
             : m_odometer(odometer)
+            , m_packedOdometer(packedOdometer)
+            , m_firstWheelDiffs(firstWheelDiffs)
             , m_remainingCombinations(count) // parameters checked in SpaceImpl::createCursor
+            , m_changedWheels(odometer.size()) // the first candidate: everything is new
         {
             m_odometerState.reserve(m_odometer.size());
 
@@ -73,6 +88,12 @@ namespace
                 offset /= wheel.size();
             }
             ENSURE(offset == 0, "");
+
+            if constexpr (Packed)
+            {
+                m_packedCandidate.resize(m_odometer.size());
+                updatePacked(AttributeTypeID{ m_odometer.size() });
+            }
         }
 
         bool moveNext() override
@@ -83,32 +104,92 @@ namespace
                 return false;
 
             // Odometer logic (mileage counter)
-            for (auto& wheelState : m_odometerState)
+            for (size_t wheelIndex = 0; wheelIndex < m_odometerState.size(); ++wheelIndex)
             {
+                auto& wheelState = m_odometerState[AttributeTypeID{ wheelIndex }];
                 // increment the first wheel
                 if (++wheelState.position < wheelState.size) [[likely]]
+                {
+                    if constexpr (Packed)
+                        m_packedCandidate[wheelIndex] = m_packedOdometer[AttributeTypeID{ wheelIndex }][wheelState.position];
+                    m_changedWheels = std::max(wheelIndex + 1, m_skippedWheels);
+                    m_skippedWheels = 0;
                     return true;
+                }
 
                 [[unlikely]]
                 // if it completes a full rotation -> reset the first wheel and increment the next wheel
                 wheelState.position = 0;
+                if constexpr (Packed)
+                    m_packedCandidate[wheelIndex] = m_packedOdometer[AttributeTypeID{ wheelIndex }].front();
             }
 
             [[unlikely]]
             return false; // last reached
         }
 
+        std::uint64_t skipTo(AttributeTypeID wheelTypeId) override
+        {
+            // Linear index of the lower wheels state and its period (combinations count of the lower wheels)
+            std::uint64_t lowerState = 0;
+            std::uint64_t period = 1;
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < wheelTypeId; ++typeId)
+            {
+                lowerState += m_odometerState[typeId].position * period;
+                period *= m_odometerState[typeId].size;
+            }
+
+            // The last lower wheels state (before the carry) or the last candidate of the range
+            const auto skipCount = std::min(period - 1 - lowerState, m_remainingCombinations - 1);
+            lowerState += skipCount;
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < wheelTypeId; ++typeId)
+            {
+                auto& wheelState = m_odometerState[typeId];
+                wheelState.position = lowerState % wheelState.size;
+                lowerState /= wheelState.size;
+            }
+            m_remainingCombinations -= skipCount;
+            if (skipCount > 0)
+            {
+                m_skippedWheels = std::max(m_skippedWheels, wheelTypeId.value());
+                if constexpr (Packed)
+                    updatePacked(wheelTypeId);
+            }
+            return skipCount;
+        }
+
+        size_t changedWheels() const override
+        {
+            return m_changedWheels;
+        }
+
+        std::uint64_t changedValues() const override
+        {
+            return m_firstWheelDiffs[m_odometerState.front().position];
+        }
+
         PersonID ownerOf(AttributeTypeID typeId, AttributeValueID valueId) const override
         {
-            return currentAssignment(typeId)[valueId];
+            if constexpr (Packed)
+                return packedOwner(m_packedCandidate[typeId.value()], valueId);
+            else
+                return currentAssignment(typeId)[valueId];
         }
 
         size_t personPosition(PersonID personId, AttributeTypeID typeId) const override
         {
+            if constexpr (Packed)
+                return packedPosition(m_packedCandidate[typeId.value()], personId);
+
             const auto& assignment = currentAssignment(typeId);
             return std::ranges::find(assignment, personId) - assignment.cbegin(); // it's rare call
         }
 
+        const PackedAssignment* packedCandidate() const override
+        {
+            return Packed ? m_packedCandidate.data() : nullptr;
+        }
+
         SolutionModel getSolutionModel() const override
         {
             // Return current combination as solution
@@ -128,8 +209,16 @@ namespace
             return m_odometer[typeId][wheelPosition];
         }
 
+        void updatePacked(AttributeTypeID endTypeId) // wheels 0..endTypeId-1
+        {
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < endTypeId; ++typeId)
+                m_packedCandidate[typeId.value()] = m_packedOdometer[typeId][m_odometerState[typeId].position];
+        }
+
     private:
-        const Odometer& m_odometer;
+        const OdometerView& m_odometer;
+        const PackedOdometer& m_packedOdometer;
+        const ValueDiffs& m_firstWheelDiffs;
 
         struct WheelState
         {
@@ -139,44 +228,296 @@ namespace
         // Optimal storage of odometer state: a continuous vector of structures with "hottest" data - fits into a pair of cache-lines
         utils::IndexedVector<AttributeTypeID, WheelState> m_odometerState;
         std::uint64_t m_remainingCombinations = 0;
+        size_t m_changedWheels = 0; // by the last move
+        size_t m_skippedWheels = 0; // lower wheels changed by skipTo() since the last move
+        std::vector<PackedAssignment> m_packedCandidate; // index: AttributeTypeID, Packed only
     };
 
     // -------------------------------- helper functions for class SpaceImpl  --------------------------------------
 
-    // For each attribute generates `wheel` - list of possible permutations of values ​​for this attribute
+    // Steinhaus-Johnson-Trotter (with Even's speedup): each next permutation differs by one adjacent transposition.
+    // Return false after the last permutation.
+    class MinimalChangePermutations
+    {
+    public:
+        explicit MinimalChangePermutations(size_t count)
+            : m_directions(count, -1)
+        {
+        }
+
+        bool next(AttributeAssignment& assignment)
+        {
+            // The largest mobile person: its neighbour in its direction is smaller
+            std::optional<size_t> mobile;
+            for (size_t index = 0; index < assignment.size(); ++index)
+            {
+                const auto person = assignment[AttributeValueID{ index }];
+                const auto neighbour = static_cast<std::ptrdiff_t>(index) + m_directions[person.value()];
+                if (neighbour >= 0 && neighbour < static_cast<std::ptrdiff_t>(assignment.size())
+                    && assignment[AttributeValueID{ static_cast<size_t>(neighbour) }] < person
+                    && (!mobile || assignment[AttributeValueID{ *mobile }] < person))
+                    mobile = index;
+            }
+            if (!mobile)
+                return false;
+
+            const auto person = assignment[AttributeValueID{ *mobile }];
+            const auto target = static_cast<size_t>(static_cast<std::ptrdiff_t>(*mobile) + m_directions[person.value()]);
+            std::swap(assignment[AttributeValueID{ *mobile }], assignment[AttributeValueID{ target }]);
+            for (size_t larger = person.value() + 1; larger < m_directions.size(); ++larger)
+                m_directions[larger] = -m_directions[larger];
+            return true;
+        }
+
+    private:
+        std::vector<std::ptrdiff_t> m_directions; // index: person, -1 - left, +1 - right
+    };
+
+    // Generates `wheel` - list of possible permutations of values for the attribute type.
     // If allowFilter specified - filtering out obviously false ones. It reduces the wheel size.
-    Odometer generateOdometer(size_t personCount, size_t attrTypeCount, SearchSpace::AllowFilter allowFilter)
+    // If allowedOwners specified - lexicographic wheels are generated by backtracking over the value domains: only consistent
+    // permutations are produced (and checked by allowFilter), instead of all N! of them.
+    // firstOwners - possible owners of the value 0 (lexicographic order only): the slice of the wheel with these prefixes.
+    std::vector<AttributeAssignment> generateWheel(size_t personCount, AttributeTypeID attrTypeId,
+        const SearchSpace::AllowFilter& allowFilter, const SearchSpace::AllowedOwners& allowedOwners, SearchSpace::WheelOrder order,
+        std::uint64_t firstOwners)
     {
-        auto generateWheel = [&allowFilter, personCount](AttributeTypeID attrTypeId)
+        // Generation of permutations (lexicographic order):
+        // start: [0, 1, 2, 3, 4] -> AttributeAssignment[value_0] = Person_0, AttributeAssignment[value_1] = Person_1, ...
+        // next:  [0, 1, 2, 4, 3] ...
+        // end:   [4, 3, 2, 1, 0]
+        // Minimal change order: [0, 1, 2], [0, 2, 1], [2, 0, 1], [2, 1, 0], [1, 2, 0], [1, 0, 2]
+
+        // Possible owners of each value (bit N - PersonID{N})
+        const auto allPersons = (personCount < 64) ? (std::uint64_t{ 1 } << personCount) - 1 : ~std::uint64_t{ 0 };
+        const bool hasDomains = (allowedOwners || (firstOwners & allPersons) != allPersons) && personCount <= 64;
+        std::vector<std::uint64_t> domains(hasDomains ? personCount : 0);
+        for (size_t index = 0; index < domains.size(); ++index)
+            domains[index] = (allowedOwners ? allowedOwners(attrTypeId, AttributeValueID{ index }) : allPersons) & allPersons;
+        if (hasDomains && personCount > 0)
+            domains[0] &= firstOwners;
+
+        std::vector<AttributeAssignment> permutationList;
+        AttributeAssignment attributeAssignment(personCount);
+        std::iota(attributeAssignment.begin(), attributeAssignment.end(), PersonID{ 0 }); // init start permutation
+        auto addPermutation = [&]()
             {
-                const bool hasFilter = static_cast<bool>(allowFilter);
-                // Generation of permutations:
-                // start: [0, 1, 2, 3, 4] -> AttributeAssignment[value_0] = Person_0, AttributeAssignment[value_1] = Person_1, ...
-                // next:  [0, 1, 2, 4, 3] ...
-                // end:   [4, 3, 2, 1, 0]
-
-                std::vector<AttributeAssignment> permutationList;
-                AttributeAssignment attributeAssignment(personCount);
-                std::iota(attributeAssignment.begin(), attributeAssignment.end(), PersonID{ 0 }); // init start permutation
-                do
+                if (!allowFilter || allowFilter(attrTypeId, attributeAssignment))
+                {
+                    permutationList.push_back(attributeAssignment);
+                }
+            };
+
+        if (hasDomains && order == SearchSpace::WheelOrder::Lexicographic)
+        {
+            // Value by value, owners in ascending order: the same lexicographic order
+            auto assign = [&attributeAssignment, &domains, &addPermutation](auto& self, size_t index, std::uint64_t usedPersons) -> void
                 {
-                    if (!hasFilter || allowFilter(attrTypeId, attributeAssignment))
+                    if (index == attributeAssignment.size())
+                        return addPermutation();
+                    for (auto candidates = domains[index] & ~usedPersons; candidates != 0; candidates &= candidates - 1)
                     {
-                        permutationList.push_back(attributeAssignment);
+                        const auto person = std::countr_zero(candidates);
+                        attributeAssignment[AttributeValueID{ index }] = PersonID{ static_cast<size_t>(person) };
+                        self(self, index + 1, usedPersons | (std::uint64_t{ 1 } << person));
                     }
-                } while (std::ranges::next_permutation(attributeAssignment).found);
+                };
+            assign(assign, 0, 0);
+            return permutationList;
+        }
 
-                return permutationList;
+        auto consistent = [&attributeAssignment, &domains]()
+            {
+                for (size_t index = 0; index < domains.size(); ++index)
+                {
+                    if (((domains[index] >> attributeAssignment[AttributeValueID{ index }].value()) & 1) == 0)
+                        return false;
+                }
+                return true;
             };
+        MinimalChangePermutations minimalChange{ personCount };
+        do
+        {
+            if (consistent())
+                addPermutation();
+        } while (order == SearchSpace::WheelOrder::MinimalChange
+            ? minimalChange.next(attributeAssignment) : std::ranges::next_permutation(attributeAssignment).found);
 
-        Odometer odometer(attrTypeCount);
+        return permutationList;
+    }
+
+    // Big lexicographic wheels are split by the owner of the value 0: the slices are contiguous, merged in the prefix order
+    constexpr size_t splitPersonCount = 8;
+
+    Odometer generateOdometer(size_t personCount, size_t attrTypeCount, const SearchSpace::AllowFilter& allowFilter,
+        const SearchSpace::AllowedOwners& allowedOwners, SearchSpace::WheelOrder order, size_t threadCount)
+    {
+        struct Task
+        {
+            AttributeTypeID typeId;
+            std::uint64_t firstOwners = ~std::uint64_t{ 0 };
+        };
+        const bool split = threadCount > 1 && order == SearchSpace::WheelOrder::Lexicographic
+            && personCount >= splitPersonCount && personCount <= 64;
+        std::vector<Task> tasks; // in the wheels order
         for (auto attrTypeId = AttributeTypeID{ 0 }; attrTypeId < AttributeTypeID{ attrTypeCount }; ++attrTypeId)
-            odometer[attrTypeId] = generateWheel(attrTypeId);
+        {
+            if (!split)
+            {
+                tasks.push_back({ attrTypeId });
+                continue;
+            }
+            for (size_t person = 0; person < personCount; ++person)
+                tasks.push_back({ attrTypeId, std::uint64_t{ 1 } << person });
+        }
 
+        Odometer odometer(attrTypeCount);
+        threadCount = std::min(threadCount, tasks.size());
+        if (threadCount <= 1)
+        {
+            for (const auto& task : tasks)
+                odometer[task.typeId] = generateWheel(personCount, task.typeId, allowFilter, allowedOwners, order, task.firstOwners);
+            return odometer;
+        }
+
+        // The filters are read-only: the tasks are shared by the workers, each slice goes to its own place
+        using Slices = std::vector<std::pair<size_t, std::vector<AttributeAssignment>>>; // task index -> wheel slice
+        std::atomic<size_t> nextTask = 0;
+        utils::ParallelExecutor<Slices> executor{ threadCount, [&](std::stop_token st)
+            {
+                Slices slices;
+                for (auto taskIndex = nextTask++; taskIndex < tasks.size() && !st.stop_requested(); taskIndex = nextTask++)
+                {
+                    const auto& task = tasks[taskIndex];
+                    slices.emplace_back(taskIndex, generateWheel(personCount, task.typeId, allowFilter, allowedOwners, order, task.firstOwners));
+                }
+                return slices;
+            } };
+
+        std::vector<std::vector<AttributeAssignment>> wheelSlices(tasks.size());
+        for (auto& slices : executor.collectResults())
+        {
+            for (auto& [taskIndex, slice] : slices)
+                wheelSlices[taskIndex] = std::move(slice);
+        }
+        for (size_t taskIndex = 0; taskIndex < tasks.size(); ++taskIndex)
+        {
+            auto& wheel = odometer[tasks[taskIndex].typeId];
+            if (wheel.empty())
+                wheel = std::move(wheelSlices[taskIndex]);
+            else
+                std::ranges::move(wheelSlices[taskIndex], std::back_inserter(wheel));
+        }
         return odometer;
     }
 
-    std::uint64_t calcTotalCombinations(const Odometer& odometer)
+    // The wheels of equal specs are generated once: found in WheelCache, or generated (in parallel, as generateOdometer) and added to it
+    SharedWheels generateSharedWheels(const SearchSpace::WheelSpecs& specs, size_t threadCount)
+    {
+        std::map<WheelSpec, std::vector<AttributeTypeID>> typesOfSpec;
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ specs.size() }; ++typeId)
+        {
+            ENSURE(specs[typeId].personCount == specs.front().personCount && specs[typeId].order == specs.front().order,
+                "The wheels of one search space must be of the same persons count and order");
+            typesOfSpec[specs[typeId]].push_back(typeId);
+        }
+
+        auto& cache = WheelCache::instance();
+        SharedWheels wheels(specs.size());
+        std::vector<const std::pair<const WheelSpec, std::vector<AttributeTypeID>>*> missed; // index: generated wheel
+        for (const auto& specTypes : typesOfSpec)
+        {
+            if (auto wheel = cache.find(specTypes.first, specTypes.second.size()))
+            {
+                for (const auto typeId : specTypes.second)
+                    wheels[typeId] = wheel;
+            }
+            else
+                missed.push_back(&specTypes);
+        }
+        if (missed.empty())
+            return wheels;
+
+        // The missed specs as attribute types of their own
+        auto specOf = [&missed](AttributeTypeID index) -> const WheelSpec& { return missed[index.value()]->first; };
+        const bool symmetry = std::ranges::any_of(missed, [](const auto* specTypes) { return !specTypes->first.ascendingOwners.empty(); });
+        SearchSpace::AllowFilter ascendingOwners;
+        if (symmetry)
+        {
+            ascendingOwners = [specOf](AttributeTypeID index, const AttributeAssignment& assignment)
+                {
+                    return std::ranges::all_of(specOf(index).ascendingOwners, [&assignment](const std::vector<AttributeValueID>& values)
+                        {
+                            return std::ranges::is_sorted(values, std::less{}, [&assignment](AttributeValueID valueId) { return assignment[valueId]; });
+                        });
+                };
+        }
+        auto owners = [specOf](AttributeTypeID index, AttributeValueID valueId) { return specOf(index).owners[valueId.value()]; };
+        auto generated = generateOdometer(specs.front().personCount, missed.size(), ascendingOwners, owners, specs.front().order, threadCount);
+
+        for (auto index = AttributeTypeID{ 0 }; index < AttributeTypeID{ missed.size() }; ++index)
+        {
+            const auto wheel = cache.add(specOf(index), std::move(generated[index]));
+            for (const auto typeId : missed[index.value()]->second)
+                wheels[typeId] = wheel;
+        }
+        return wheels;
+    }
+
+    ValueDiffs calcFirstWheelDiffs(const OdometerView& odometer)
+    {
+        ValueDiffs diffs{ platform::largePages() };
+        if (odometer.size() == 0) // NOLINT(readability-container-size-empty)
+            return diffs;
+
+        const auto& wheel = odometer.front();
+        diffs.reserve(wheel.size());
+        for (size_t position = 0; position < wheel.size(); ++position)
+        {
+            std::uint64_t diff = (position == 0 || wheel[position].size() > 64) ? ~std::uint64_t{ 0 } : 0;
+            for (auto valueId = AttributeValueID{ 0 }; position > 0 && valueId < AttributeValueID{ std::min<size_t>(wheel[position].size(), 64) }; ++valueId)
+            {
+                if (wheel[position][valueId] != wheel[position - 1][valueId])
+                    diff |= std::uint64_t{ 1 } << valueId.value();
+            }
+            diffs.push_back(diff);
+        }
+        return diffs;
+    }
+
+    SharedWheels share(Odometer&& odometer)
+    {
+        SharedWheels wheels;
+        wheels.reserve(odometer.size());
+        for (auto& wheel : odometer)
+            wheels.push_back(std::make_shared<const Wheel>(std::move(wheel)));
+        return wheels;
+    }
+
+    OdometerView viewOdometer(const SharedWheels& wheels)
+    {
+        OdometerView view;
+        view.reserve(wheels.size());
+        for (const auto& wheel : wheels)
+            view.emplace_back(wheel->permutations);
+        return view;
+    }
+
+    PackedOdometer viewPackedOdometer(const SharedWheels& wheels)
+    {
+        PackedOdometer view;
+        const bool packable = std::ranges::all_of(wheels, [](const SharedWheel& wheel)
+            { return !wheel->permutations.empty() && wheel->packed.size() == wheel->permutations.size(); });
+        if (!packable)
+            return view;
+
+        view.reserve(wheels.size());
+        for (const auto& wheel : wheels)
+            view.emplace_back(wheel->packed);
+        return view;
+    }
+
+    std::uint64_t calcTotalCombinations(const OdometerView& odometer)
     {
         std::uint64_t totalCombinations = 1;
         for (const auto& wheel : odometer)
@@ -195,8 +536,11 @@ namespace
     class SpaceImpl final : public SearchSpace
     {
     public:
-        explicit SpaceImpl(Odometer&& odometer)
-            : m_odometer(std::move(odometer))
+        explicit SpaceImpl(SharedWheels wheels)
+            : m_wheels(std::move(wheels))
+            , m_odometer(viewOdometer(m_wheels))
+            , m_packedOdometer(viewPackedOdometer(m_wheels))
+            , m_firstWheelDiffs(calcFirstWheelDiffs(m_odometer))
             , m_totalCombinations(calcTotalCombinations(m_odometer))
         {
         }
@@ -206,16 +550,43 @@ namespace
             return m_totalCombinations;
         }
 
+        size_t wheelSize(AttributeTypeID typeId) const override
+        {
+            return m_odometer[typeId].size();
+        }
+
+        const std::vector<AttributeAssignment>& wheel(AttributeTypeID typeId) const override
+        {
+            return m_wheels[typeId]->permutations;
+        }
+
+        std::unique_ptr<SearchSpace> project(const std::vector<AttributeTypeID>& types) const override
+        {
+            SharedWheels wheels = m_wheels; // the projected ones are shared
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ wheels.size() }; ++typeId)
+            {
+                const auto& permutations = m_wheels[typeId]->permutations;
+                if (std::ranges::find(types, typeId) == types.end())
+                    wheels[typeId] = std::make_shared<const Wheel>(std::vector(permutations.begin(), permutations.begin() + std::min<size_t>(permutations.size(), 1)));
+            }
+            return std::make_unique<SpaceImpl>(std::move(wheels));
+        }
+
         std::unique_ptr<SearchSpaceCursor> createCursor(std::uint64_t offset, std::uint64_t count) const override
         {
             if (m_totalCombinations == 0 || count == 0 || offset >= m_totalCombinations || count > m_totalCombinations - offset)
                 return {};
 
-            return std::make_unique<CursorImpl>(m_odometer, offset, count);
+            if (m_packedOdometer.size() != 0) // NOLINT(readability-container-size-empty)
+                return std::make_unique<CursorImpl<true>>(m_odometer, m_packedOdometer, m_firstWheelDiffs, offset, count);
+            return std::make_unique<CursorImpl<false>>(m_odometer, m_packedOdometer, m_firstWheelDiffs, offset, count);
         }
 
     private:
-        const Odometer m_odometer;
+        const SharedWheels m_wheels;
+        const OdometerView m_odometer;
+        const PackedOdometer m_packedOdometer;
+        const ValueDiffs m_firstWheelDiffs;
         const std::uint64_t m_totalCombinations;
     };
 
@@ -223,8 +594,24 @@ namespace
 
     // -------------------------------- class SearchSpace ------------------------------------------------
 
-    std::unique_ptr<SearchSpace> SearchSpace::create(size_t personCount, size_t attrTypeCount, AllowFilter filter)
+    std::unique_ptr<SearchSpace> SearchSpace::create(size_t personCount, size_t attrTypeCount, AllowFilter filter, WheelOrder order,
+        AllowedOwners allowedOwners, size_t threadCount)
     {
-        return std::make_unique<SpaceImpl>(generateOdometer(personCount, attrTypeCount, std::move(filter)));
+        return std::make_unique<SpaceImpl>(share(generateOdometer(personCount, attrTypeCount, filter, allowedOwners, order, threadCount)));
+    }
+
+    std::unique_ptr<SearchSpace> SearchSpace::create(const WheelSpecs& specs, size_t threadCount)
+    {
+        return std::make_unique<SpaceImpl>(generateSharedWheels(specs, threadCount));
+    }
+
+    std::unique_ptr<SearchSpace> SearchSpace::create(Wheels wheels)
+    {
+        for (const auto& wheel : wheels)
+        {
+            ENSURE(std::ranges::all_of(wheel, [&wheel](const AttributeAssignment& assignment) { return assignment.size() == wheel.front().size(); }),
+                "Permutations of one wheel must be of the same size");
+        }
+        return std::make_unique<SpaceImpl>(share(std::move(wheels)));
     }
 }
@@ -1,5 +1,7 @@
 #pragma once
+#include "epuzzle/SolverConfig.h"
 #include "SearchSpaceCursor.h"
+#include "WheelCache.h"
 
 namespace epuzzle::details::bruteforce
 {
@@ -10,11 +12,31 @@ namespace epuzzle::details::bruteforce
     public:
         // AllowFilter can exclude AttributeAssignment with a known invalid combination of attribute value bindings to persons.
         using AllowFilter = std::function<bool(AttributeTypeID, const AttributeAssignment&)>;
+        // AllowedOwners - possible owners of the value (bit N - PersonID{N}, for persons count <= 64). The wheels contain only
+        // permutations consistent with these domains; lexicographic ones are generated by backtracking, without the rest of N!.
+        using AllowedOwners = std::function<std::uint64_t(AttributeTypeID, AttributeValueID)>;
+        using WheelOrder = SolverConfig::BruteForceConfig::WheelOrder;
+        // Index: AttributeTypeID -> allowed permutations of the attribute type
+        using Wheels = utils::IndexedVector<AttributeTypeID, std::vector<AttributeAssignment>>;
 
-        static std::unique_ptr<SearchSpace> create(size_t personCount, size_t attrTypeCount, AllowFilter);
+        // threadCount > 1: the wheels (and slices of big lexicographic wheels) are generated in parallel,
+        // AllowFilter and AllowedOwners must be thread-safe then.
+        static std::unique_ptr<SearchSpace> create(size_t personCount, size_t attrTypeCount, AllowFilter,
+            WheelOrder = WheelOrder::Lexicographic, AllowedOwners = {}, size_t threadCount = 1);
+        // Over prebuilt wheels (e.g. of a compiled puzzle, see WheelStore): nothing is generated
+        static std::unique_ptr<SearchSpace> create(Wheels);
+        // The wheels of the specs (the same persons count and order): taken from the process-wide WheelCache or generated and
+        // added to it, the wheels of equal specs are generated once. Persons count <= 64.
+        using WheelSpecs = utils::IndexedVector<AttributeTypeID, WheelSpec>;
+        static std::unique_ptr<SearchSpace> create(const WheelSpecs&, size_t threadCount = 1);
         virtual ~SearchSpace() = default;
 
         virtual std::uint64_t totalSolutionCandidates() const = 0;
+        virtual size_t wheelSize(AttributeTypeID) const = 0; // count of allowed permutations of the attribute type
+        virtual const std::vector<AttributeAssignment>& wheel(AttributeTypeID) const = 0; // allowed permutations of the attribute type
+        // Sub space of the given types: other wheels are reduced to their first permutation (the caller must ignore these types).
+        // Type ids are kept, so cursors of the sub space are compatible with constraint checkers.
+        [[nodiscard]] virtual std::unique_ptr<SearchSpace> project(const std::vector<AttributeTypeID>&) const = 0;
 
         // Cursor range: offset - initial position, count - cursor range length
         [[nodiscard]] virtual std::unique_ptr<SearchSpaceCursor> createCursor(std::uint64_t offset, std::uint64_t count) const = 0;
@@ -3,6 +3,32 @@
 
 namespace epuzzle::details::bruteforce
 {
+    // Attribute assignment packed into one word (for persons count <= maxPackedPersons), 4 bits per item:
+    // low half - owner of each value (nibble N - owner of AttributeValueID{N}), high half - inverse: value of each person (position).
+    using PackedAssignment = std::uint64_t;
+    constexpr size_t maxPackedPersons = 8;
+
+    inline PersonID packedOwner(PackedAssignment assignment, AttributeValueID valueId)
+    {
+        return PersonID{ static_cast<size_t>((assignment >> (4 * valueId.value())) & 0xF) };
+    }
+
+    inline size_t packedPosition(PackedAssignment assignment, PersonID personId)
+    {
+        return static_cast<size_t>((assignment >> (32 + 4 * personId.value())) & 0xF);
+    }
+
+    inline PackedAssignment pack(const AttributeAssignment& assignment)
+    {
+        PackedAssignment packed = 0;
+        for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ assignment.size() }; ++valueId)
+        {
+            packed |= PackedAssignment{ assignment[valueId].value() } << (4 * valueId.value());
+            packed |= PackedAssignment{ valueId.value() } << (32 + 4 * assignment[valueId].value());
+        }
+        return packed;
+    }
+
     // Navigates through the SearchSpace in some range and provides access to the current solution candidate. 
     class SearchSpaceCursor
     {
@@ -12,8 +38,21 @@ namespace epuzzle::details::bruteforce
         // Move to next solution candidate
         [[nodiscard]] virtual bool moveNext() = 0;
 
+        // Skip the candidates with the same states of the wheel and higher ones (the lower wheels vary only), within the cursor range:
+        // the cursor stays at the last of them, so the next moveNext() reaches the next state of the wheel.
+        // Return count of skipped candidates. By default nothing is skipped (valid for any cursor).
+        virtual std::uint64_t skipTo(AttributeTypeID) { return 0; }
+
+        // Incremental revalidation: the last move changed the wheels 0..changedWheels()-1 only (others kept their states).
+        // If it is the first wheel only - changedValues() are its values whose owners changed (bit N - AttributeValueID{N}).
+        // By default everything changes.
+        virtual size_t changedWheels() const { return std::numeric_limits<size_t>::max(); }
+        virtual std::uint64_t changedValues() const { return ~std::uint64_t{ 0 }; }
+
         virtual PersonID ownerOf(AttributeTypeID, AttributeValueID) const = 0;
         virtual size_t personPosition(PersonID, AttributeTypeID) const = 0;
+        // Current candidate as packed assignments (index: AttributeTypeID), if the cursor supports it. Valid until the next move.
+        virtual const PackedAssignment* packedCandidate() const { return nullptr; }
 
         // Get current combination as solution
         virtual SolutionModel getSolutionModel() const = 0;
@@ -1,4 +1,5 @@
 #include "SequentialSolver.h"
+#include "SpaceSplitter.h"
 
 namespace epuzzle::details::bruteforce
 {
@@ -8,18 +9,36 @@ namespace epuzzle::details::bruteforce
     {
     }
 
-    std::vector<PuzzleSolution> SequentialSolver::solve(const SolveOptions& opts)
+    std::vector<PuzzleSolution> SequentialSolver::search(const SolveOptions& opts) const
     {
         std::vector<PuzzleSolution> solutions;
         constexpr auto minCountInterval = 1'000'000u;
         utils::ProgressTracker tracker(m_ctx.searchSpace().totalSolutionCandidates(), opts.progressInterval, minCountInterval, opts.progressCallback);
 
-        if (auto cursor = m_ctx.searchSpace().createCursor())
+        const auto& space = m_ctx.searchSpace();
+        if (space.totalSolutionCandidates() == 0)
         {
+            tracker.finish();
+            return solutions;
+        }
+
+        // By chunks as the parallel search: the checks are re-ranked between them (see Validator::rerank)
+        auto validatorCache = m_ctx.validator().createCache();
+        SpaceSplitter spaceSplitter{ space.totalSolutionCandidates() };
+        while (const auto chunk = spaceSplitter.nextChunk())
+        {
+            auto cursor = space.createCursor(chunk->offset, chunk->count);
+            ENSURE(cursor, "cursor must be created!");
+            m_ctx.validator().rerank(validatorCache);
             do
             {
                 // Hot cycle!
-                if (m_ctx.validator().isSolutionValid(*cursor)) [[unlikely]]
+                if (const auto failedWheel = m_ctx.validator().failedWheel(*cursor, validatorCache)) [[likely]]
+                {
+                    if (!tracker.update(cursor->skipTo(*failedWheel))) [[unlikely]] // user canceled
+                        return solutions;
+                }
+                else
                 {
                     solutions.push_back(cursor->getSolutionModel().toPuzzleSolution(m_ctx.puzzleModel()));
                 }
@@ -28,8 +47,6 @@ namespace epuzzle::details::bruteforce
 
             } while (cursor->moveNext());
         }
-        else
-            tracker.finish();
 
         return solutions;
     }
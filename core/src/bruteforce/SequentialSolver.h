@@ -11,7 +11,12 @@ namespace epuzzle::details::bruteforce
     public:
         explicit SequentialSolver(SolverContext&&);
 
-        std::vector<PuzzleSolution> solve(const SolveOptions&) override;
+        std::vector<PuzzleSolution> solve(const SolveOptions& opts) override { return solveSet(opts).toVector(); }
+        SolutionSet solveSet(const SolveOptions& opts) override { return m_ctx.makeSolutionSet(search(opts)); }
+        Statistics statistics() const override { return m_ctx.statistics(); }
+
+    private:
+        std::vector<PuzzleSolution> search(const SolveOptions&) const; // canonical solutions (see SolverContext::makeSolutionSet)
 
     private:
         SolverContext m_ctx;
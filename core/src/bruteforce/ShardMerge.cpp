@@ -0,0 +1,82 @@
+#include "epuzzle/Exceptions.h"
+#include "epuzzle/Solver.h"
+#include "Checkpoint.h"
+
+namespace epuzzle
+{
+    namespace
+    {
+        using details::bruteforce::Checkpoint;
+        using Chunk = details::bruteforce::SpaceSplitter::Chunk;
+
+        void mergeFiles(const std::vector<std::filesystem::path>& shardFiles, const std::filesystem::path& mergedFile)
+        {
+            std::optional<Checkpoint::File> merged;
+            std::vector<Chunk> done;
+            std::set<std::string> seen; // of solutions, printed
+            for (const auto& path : shardFiles)
+            {
+                auto file = Checkpoint::read(path);
+                if (!file)
+                    throw SolverConfigError("No shard result file: " + path.string());
+                if (!merged)
+                    merged = Checkpoint::File{ .fingerprint = file->fingerprint, .totalCandidates = file->totalCandidates, .state = {} };
+                else if (file->fingerprint != merged->fingerprint || file->totalCandidates != merged->totalCandidates)
+                    throw SolverConfigError("The shard result file is of another puzzle or solver config: " + path.string());
+
+                std::ranges::copy(file->state.done, std::back_inserter(done));
+                for (auto& solution : file->state.solutions)
+                {
+                    std::ostringstream key;
+                    key << solution;
+                    if (seen.insert(key.str()).second)
+                        merged->state.solutions.push_back(std::move(solution));
+                }
+            }
+
+            // Overlapping shards (e.g. rerun with another count) are fine, gaps are not
+            std::ranges::sort(done, std::less{}, &Chunk::offset);
+            std::uint64_t covered = 0;
+            for (const auto& chunk : done)
+            {
+                if (chunk.offset > covered)
+                    break;
+                covered = std::max(covered, chunk.offset + chunk.count);
+            }
+            if (covered < merged->totalCandidates)
+            {
+                throw SolverConfigError("The shard results don't cover the search space: candidates from " + std::to_string(covered)
+                    + " of " + std::to_string(merged->totalCandidates) + " are not searched (a shard is missing or unfinished)");
+            }
+            if (merged->totalCandidates > 0)
+                merged->state.done.push_back({ .offset = 0, .count = merged->totalCandidates });
+
+            Checkpoint::write(mergedFile, *merged);
+        }
+
+        std::filesystem::path withSuffix(std::filesystem::path path, const std::string& suffix)
+        {
+            return path += suffix;
+        }
+    }
+
+    void mergeShards(const std::vector<std::filesystem::path>& shardFiles, const std::filesystem::path& mergedFile)
+    {
+        if (shardFiles.empty())
+            throw SolverConfigError("No shard result files to merge");
+
+        // Decomposed puzzle: each part is sharded separately (see DecomposedSolver)
+        if (!std::filesystem::exists(shardFiles.front()) && std::filesystem::exists(withSuffix(shardFiles.front(), ".part1")))
+        {
+            for (size_t part = 1; std::filesystem::exists(withSuffix(shardFiles.front(), ".part" + std::to_string(part))); ++part)
+            {
+                const auto suffix = ".part" + std::to_string(part);
+                std::vector<std::filesystem::path> partFiles;
+                std::ranges::transform(shardFiles, std::back_inserter(partFiles), [&suffix](const auto& path) { return withSuffix(path, suffix); });
+                mergeFiles(partFiles, withSuffix(mergedFile, suffix));
+            }
+            return;
+        }
+        mergeFiles(shardFiles, mergedFile);
+    }
+}
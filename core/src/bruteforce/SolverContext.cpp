@@ -0,0 +1,172 @@
+#include "epuzzle/Exceptions.h"
+#include "presolve/Propagator.h"
+#include "SolverContext.h"
+
+namespace epuzzle::details::bruteforce
+{
+
+    SolverContext::SolverContext(PuzzleModel&& puzzleModel, const SolverConfig::BruteForceConfig& config, WheelStore* wheelStore)
+        : m_model(std::move(puzzleModel))
+        , m_validator(m_model.attrTypeCount(), m_model.constraints(), config.prefilter)
+    {
+        if (config.breakSymmetry)
+            m_symmetry = interchangeableValues(m_model); // the solution set expands the canonical solutions of prebuilt wheels too
+
+        const auto wheelsKey = wheelStore ? WheelStore::key(m_model) : 0;
+        if (const auto* wheels = wheelStore ? wheelStore->find(wheelsKey) : nullptr)
+        {
+            // The permutations are checked by the loading (see CompiledPuzzle::load), their count and size - here, by the model
+            if (wheels->size() != m_model.attrTypeCount()
+                || !std::ranges::all_of(*wheels, [this](const auto& wheel) { return wheel.empty() || wheel.front().size() == m_model.personCount(); }))
+            {
+                throw PuzzleSyntaxError("The prebuilt wheels of the compiled puzzle don't match its model, compile the puzzle again");
+            }
+            m_space = SearchSpace::create(*wheels);
+            m_prebuiltWheels = true;
+            return;
+        }
+
+        if (config.presolve && m_model.personCount() <= presolve::Domains::maxPersonCount)
+        {
+            const presolve::Propagator propagator{ m_model };
+            m_domains = propagator.initialDomains();
+            m_contradiction = !propagator.propagate(*m_domains);
+        }
+
+        // see Validator class description; the domains (if any) make the filter stronger: each wheel contains only consistent permutations
+        auto allowFilter = [this](AttributeTypeID typeId, const AttributeAssignment& assignment)
+            {
+                return !m_contradiction
+                    && m_validator.isAttributeAssignmentValid(typeId, assignment)
+                    && (!m_domains || m_domains->allows(typeId, assignment))
+                    && isCanonical(typeId, assignment);
+            };
+        // The same restrictions as value domains: the wheels are generated by backtracking over them
+        auto allowedOwners = [this](AttributeTypeID typeId, AttributeValueID valueId)
+            {
+                return m_validator.allowedOwners(typeId, valueId) & (m_domains ? m_domains->owners(typeId, valueId) : ~std::uint64_t{ 0 });
+            };
+        // The same threads count as the parallel search: the preparation scales with cores too
+        const size_t threadCount = (config.execution == SolverConfig::BruteForceConfig::ExecPolicy::Parallel)
+            ? std::max(1u, std::jthread::hardware_concurrency()) : 1;
+        if (m_model.personCount() > presolve::Domains::maxPersonCount)
+        {
+            m_space = SearchSpace::create(m_model.personCount(), m_model.attrTypeCount(), allowFilter, config.wheelOrder, allowedOwners, threadCount);
+        }
+        else
+        {
+            // The same filter as a canonical spec (the domains and the symmetry order): equal wheels are shared across puzzles
+            const auto allPersons = (m_model.personCount() < 64) ? (std::uint64_t{ 1 } << m_model.personCount()) - 1 : ~std::uint64_t{ 0 };
+            SearchSpace::WheelSpecs specs(m_model.attrTypeCount());
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ m_model.attrTypeCount() }; ++typeId)
+            {
+                auto& spec = specs[typeId];
+                spec.personCount = m_model.personCount();
+                spec.order = config.wheelOrder;
+                for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ m_model.personCount() }; ++valueId)
+                    spec.owners.push_back(m_contradiction ? 0 : allowedOwners(typeId, valueId) & allPersons);
+                for (const auto& group : m_symmetry)
+                {
+                    if (group.typeId == typeId)
+                        spec.ascendingOwners.push_back(group.values);
+                }
+                std::ranges::sort(spec.ascendingOwners);
+            }
+            m_space = SearchSpace::create(specs, threadCount);
+        }
+
+        if (wheelStore && wheelStore->recording())
+        {
+            SearchSpace::Wheels wheels(m_model.attrTypeCount());
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ m_model.attrTypeCount() }; ++typeId)
+                wheels[typeId] = m_space->wheel(typeId);
+            wheelStore->add(wheelsKey, std::move(wheels));
+        }
+    }
+
+    bool SolverContext::isCanonical(AttributeTypeID typeId, const AttributeAssignment& assignment) const
+    {
+        return std::ranges::all_of(m_symmetry, [typeId, &assignment](const InterchangeableValues& group)
+            {
+                return group.typeId != typeId
+                    || std::ranges::is_sorted(group.values, std::less{}, [&assignment](AttributeValueID valueId) { return assignment[valueId]; });
+            });
+    }
+
+    SolutionSet SolverContext::makeSolutionSet(std::vector<PuzzleSolution> canonicalSolutions) const
+    {
+        std::vector<std::string> attributeOrder;
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ m_model.attrTypeCount() }; ++typeId)
+            attributeOrder.emplace_back(m_model.attrTypeName(typeId));
+
+        std::vector<SolutionSet::ValueGroup> groups;
+        for (const auto& [typeId, values] : m_symmetry)
+        {
+            auto& group = groups.emplace_back(std::string(m_model.attrTypeName(typeId)), std::vector<std::string>{});
+            for (const auto valueId : values)
+                group.values.emplace_back(m_model.attrValueName(typeId, valueId));
+        }
+
+        std::vector<std::vector<PuzzleSolution>> parts;
+        parts.push_back(std::move(canonicalSolutions));
+        return SolutionSet{ std::move(parts), std::move(attributeOrder), std::move(groups) };
+    }
+
+    std::uint64_t SolverContext::fingerprint() const
+    {
+        std::ostringstream definition;
+        definition << m_model.definition();
+        auto hash = utils::fnv1a(definition.str());
+        std::string row;
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ m_model.attrTypeCount() }; ++typeId)
+        {
+            for (const auto& assignment : m_space->wheel(typeId))
+            {
+                row.clear();
+                for (const auto personId : assignment)
+                    row.push_back(static_cast<char>(personId.value()));
+                hash = utils::fnv1a(row, hash);
+            }
+            hash = utils::fnv1a("|", hash); // wheel boundary
+        }
+        return hash;
+    }
+
+    Solver::Statistics SolverContext::statistics() const
+    {
+        Solver::Statistics stats;
+        if (m_prebuiltWheels)
+            stats.emplace_back("Wheels", "prebuilt (compiled puzzle), no presolve and generation");
+        if (m_domains)
+        {
+            const auto personCount = m_model.personCount();
+            size_t fixedCount = 0;
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ m_model.attrTypeCount() }; ++typeId)
+                fixedCount += m_domains->fixedCount(typeId);
+            stats.emplace_back("Presolve", m_contradiction ? "contradiction found, no solutions" :
+                std::to_string(fixedCount) + " of " + std::to_string(personCount * m_model.attrTypeCount()) + " values fixed");
+        }
+
+        for (const auto& [typeId, values] : m_symmetry)
+        {
+            stats.emplace_back("Interchangeable values of '" + std::string(m_model.attrTypeName(typeId)) + "'",
+                std::to_string(values.size()) + " (canonical order only, " + std::to_string(utils::factorial(values.size())) + "x less)");
+        }
+
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ m_model.attrTypeCount() }; ++typeId)
+        {
+            std::string value = std::to_string(m_space->wheelSize(typeId)) + " permutations";
+            if (m_domains)
+            {
+                value += " (" + std::to_string(m_domains->fixedCount(typeId)) + " fixed values, "
+                    + std::to_string(m_domains->allowedCount(typeId)) + " allowed person x value cells)";
+            }
+            stats.emplace_back("Wheel '" + std::string(m_model.attrTypeName(typeId)) + "'", std::move(value));
+        }
+        stats.emplace_back("Solution candidates", std::to_string(m_space->totalSolutionCandidates()));
+        stats.emplace_back("Wheel cache (process-wide)", WheelCache::instance().statsText()); // live, all the solvers
+        stats.emplace_back("Large tables memory (process-wide)", platform::LargePageResource::instance().usageText()); // live, all the solvers
+        return stats;
+    }
+
+}
@@ -1,7 +1,10 @@
 #pragma once
+#include "epuzzle/Solver.h"
 #include "PuzzleModel.h"
+#include "presolve/Domains.h"
 #include "Validator.h"
 #include "SearchSpace.h"
+#include "WheelStore.h"
 
 namespace epuzzle::details::bruteforce
 {
@@ -9,23 +12,31 @@ namespace epuzzle::details::bruteforce
     class SolverContext
     {
     public:
-        SolverContext(PuzzleModel&& puzzleModel, bool usePrefiltering)
-            : m_model(std::move(puzzleModel))
-            , m_validator(m_model.attrTypeCount(), m_model.constraints(), usePrefiltering)
-        {
-            using namespace std::placeholders;
-            // see Validator class description
-            m_space = SearchSpace::create(m_model.personCount(), m_model.attrTypeCount(),
-                std::bind(&Validator::isAttributeAssignmentValid, &m_validator, _1, _2));
-        }
+        // WheelStore (optional): the prebuilt wheels are taken from it (no presolve, no generation) or the generated ones are recorded
+        SolverContext(PuzzleModel&&, const SolverConfig::BruteForceConfig&, WheelStore* = nullptr);
 
         const PuzzleModel& puzzleModel() const { return m_model; }
         const Validator& validator() const { return m_validator; }
         const SearchSpace& searchSpace() const { return *m_space; }
 
+        Solver::Statistics statistics() const;
+        // Identifies the search space (the puzzle, the constraints and the wheels, so the candidate indexes): stable across runs
+        std::uint64_t fingerprint() const;
+        // Search finds canonical solutions only (if symmetry breaking is on): the set expands them on access
+        SolutionSet makeSolutionSet(std::vector<PuzzleSolution> canonicalSolutions) const;
+
+    private:
+        bool isCanonical(AttributeTypeID, const AttributeAssignment&) const;
+
     private:
         PuzzleModel m_model;
         Validator m_validator;
+        // Reduced person x value domains (hybrid mode: deductive presolve before bruteforce)
+        std::optional<presolve::Domains> m_domains;
+        bool m_contradiction = false; // presolve proved: there are no solutions
+        bool m_prebuiltWheels = false; // taken from WheelStore
+        // Symmetry breaking: wheels contain only permutations where owners of interchangeable values are ascending
+        std::vector<InterchangeableValues> m_symmetry;
         std::unique_ptr<SearchSpace> m_space;
     };
 
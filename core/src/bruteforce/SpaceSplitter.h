@@ -6,25 +6,34 @@ namespace epuzzle::details::bruteforce
     class SpaceSplitter
     {
     public:
-        explicit SpaceSplitter(std::uint64_t totalItems, std::uint64_t chunkSize = 10'000'000) // chunkSize could be specified in the config-file
-            : m_totalItems(totalItems)
-            , m_chunkSize(chunkSize)
-        {
-        }
-
         struct Chunk
         {
             std::uint64_t offset = 0;
             std::uint64_t count = 0;
         };
 
+        static constexpr std::uint64_t defaultChunkSize = 10'000'000; // could be specified in the config-file
+
+        // skipped - the ranges processed already (e.g. by a resumed search): sorted, not overlapping. No chunk crosses them.
+        explicit SpaceSplitter(std::uint64_t totalItems, std::uint64_t chunkSize = defaultChunkSize, std::vector<Chunk> skipped = {})
+            : m_totalItems(totalItems)
+            , m_chunkSize(chunkSize)
+            , m_skipped(std::move(skipped))
+        {
+        }
+
         std::optional<Chunk> nextChunk()
         {
             const std::lock_guard<std::mutex>lock(m_distributedGuard);
+            for (; m_nextSkipped < m_skipped.size() && m_skipped[m_nextSkipped].offset <= m_distributed; ++m_nextSkipped)
+                m_distributed = std::max(m_distributed, m_skipped[m_nextSkipped].offset + m_skipped[m_nextSkipped].count);
             if (m_distributed >= m_totalItems)
                 return {};
 
-            const Chunk chunk{ .offset = m_distributed, .count = std::min(m_chunkSize, m_totalItems - m_distributed) };
+            auto end = m_totalItems;
+            if (m_nextSkipped < m_skipped.size())
+                end = std::min(end, m_skipped[m_nextSkipped].offset);
+            const Chunk chunk{ .offset = m_distributed, .count = std::min(m_chunkSize, end - m_distributed) };
             m_distributed += chunk.count;
             return chunk;
         }
@@ -32,6 +41,9 @@ namespace epuzzle::details::bruteforce
     private:
         const std::uint64_t m_totalItems;
         const std::uint64_t m_chunkSize;
+        const std::vector<Chunk> m_skipped;
+
+        size_t m_nextSkipped = 0;
 
         std::uint64_t m_distributed = 0;
         std::mutex m_distributedGuard;
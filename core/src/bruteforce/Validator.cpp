@@ -2,11 +2,41 @@
 
 namespace epuzzle::details::bruteforce
 {
+namespace
+{
+    std::uint64_t dependentValues(const ConstraintModel& constraint, AttributeTypeID wheel)
+    {
+        constexpr auto allValues = ~std::uint64_t{ 0 };
+        std::uint64_t values = 0;
+        auto add = [&values, wheel](const Attribute& attr)
+            {
+                if (attr.typeId == wheel)
+                    values |= (attr.valueId.value() < 64) ? std::uint64_t{ 1 } << attr.valueId.value() : allValues;
+            };
+        std::visit(utils::overloaded
+            {
+                [&add](const PersonProperty& property) { add(property.attr); },
+                [&add](const SameOwner& sameOwner) { add(sameOwner.first); add(sameOwner.second); },
+                [&add, &values, wheel](const PositionComparison& comparison)
+                {
+                    if (comparison.compareByType == wheel) // positions of the persons whose values are swapped are changed
+                        values = allValues;
+                    for (const auto* comparable : { &comparison.first, &comparison.second })
+                    {
+                        if (const auto* attr = std::get_if<Attribute>(comparable))
+                            add(*attr);
+                    }
+                }
+            }, constraint);
+        return values;
+    }
+} // namespace
+
     Validator::Validator(size_t attrTypeCount, const std::vector<ConstraintModel>& constraints, bool needPrefiltering)
         : m_prefilters(attrTypeCount)
     {
         // reserve space for all constraints at once, it's not so much
-        m_constraintCheckers.reserve(constraints.size());
+        m_checks.reserve(constraints.size());
         for (const auto& constraint : constraints)
         {
             const auto* personProperty = std::get_if<PersonProperty>(&constraint);
@@ -16,12 +46,17 @@ namespace epuzzle::details::bruteforce
             }
             else
             {
-                m_constraintCheckers.push_back(ConstraintChecker::create(constraint));
+                const auto lowestWheel = involvedAttrTypes(constraint).front();
+                m_checks.push_back({ ConstraintChecker::create(constraint), lowestWheel, dependentValues(constraint, lowestWheel) });
             }
         };
 
-        // We'll check constraints from simplest to most complex
-        std::ranges::sort(m_constraintCheckers, {}, &ConstraintChecker::complexity);
+        // Higher wheels first: their results are mostly reused (they rarely change), and a failure skips more.
+        // Then from simplest to most complex.
+        std::ranges::sort(m_checks, [](const Check& left, const Check& right)
+            {
+                return std::pair{ right.lowestWheel, left.checker->complexity() } < std::pair{ left.lowestWheel, right.checker->complexity() };
+            });
     }
 
     bool Validator::isAttributeAssignmentValid(AttributeTypeID attrTypeId, const AttributeAssignment& assignment) const
@@ -37,16 +72,85 @@ namespace epuzzle::details::bruteforce
         return true;
     }
 
+    std::uint64_t Validator::allowedOwners(AttributeTypeID attrTypeId, AttributeValueID valueId) const
+    {
+        auto owners = ~std::uint64_t{ 0 };
+        for (const auto& property : m_prefilters[attrTypeId])
+        {
+            const auto person = std::uint64_t{ 1 } << property.person.value();
+            if (property.attr.valueId == valueId)
+                owners &= property.negate ? ~person : person;
+            else if (!property.negate)
+                owners &= ~person; // the person owns another value
+        }
+        return owners;
+    }
+
     bool Validator::isSolutionValid(const SearchSpaceCursor& solutionCandidate) const
+    {
+        return std::ranges::all_of(m_checks, [&solutionCandidate](const Check& check) { return check.checker->satisfiedBy(solutionCandidate); });
+    }
+
+    Validator::Cache Validator::createCache() const
+    {
+        Cache cache;
+        cache.m_entries.resize(m_checks.size());
+        cache.m_order.resize(m_checks.size());
+        std::iota(cache.m_order.begin(), cache.m_order.end(), 0u);
+        return cache;
+    }
+
+    void Validator::rerank(Cache& cache) const
+    {
+        // Expected cost of a check until the rejection: complexity / rejection probability.
+        // The groups of one lowest wheel keep their order (see the constructor), only checks inside a group are re-ranked.
+        auto score = [this, &cache](std::uint32_t checkIndex)
+            {
+                const auto& entry = cache.m_entries[checkIndex];
+                const double rejectRate = (static_cast<double>(entry.rejected) + 1.0) / (static_cast<double>(entry.evaluated) + 2.0); // Laplace smoothing
+                return static_cast<double>(m_checks[checkIndex].checker->complexity()) / rejectRate;
+            };
+        std::ranges::stable_sort(cache.m_order, [this, &score](std::uint32_t left, std::uint32_t right)
+            {
+                if (m_checks[left].lowestWheel != m_checks[right].lowestWheel)
+                    return m_checks[left].lowestWheel > m_checks[right].lowestWheel;
+                return score(left) < score(right);
+            });
+
+        for (auto& entry : cache.m_entries) // decay: the order follows the current part of the search space
+        {
+            entry.evaluated /= 2;
+            entry.rejected /= 2;
+        }
+    }
+
+    std::optional<AttributeTypeID> Validator::failedWheel(const SearchSpaceCursor& solutionCandidate, Cache& cache) const
     {
         // Hot path!
-        for (const auto& constraintChecker : m_constraintCheckers)
+        const auto candidate = ++cache.m_candidate;
+
+        const auto changedWheels = solutionCandidate.changedWheels();
+        const auto changedValues = (changedWheels == 1) ? solutionCandidate.changedValues() : ~std::uint64_t{ 0 };
+        const auto* packed = solutionCandidate.packedCandidate();
+        for (const auto checkIndex : cache.m_order)
         {
-            if (!constraintChecker->satisfiedBy(solutionCandidate)) [[likely]]
-                return false;
+            const auto& check = m_checks[checkIndex];
+            auto& cached = cache.m_entries[checkIndex];
+            const bool unchanged = check.lowestWheel.value() >= changedWheels || (check.lowestWheelValues & changedValues) == 0;
+            if (cached.candidate + 1 != candidate || !unchanged)
+            {
+                cached.satisfied = packed ? check.checker->satisfiedBy(packed) : check.checker->satisfiedBy(solutionCandidate);
+                ++cached.evaluated;
+                cached.rejected += !cached.satisfied;
+                ++cache.m_evaluations;
+            }
+            cached.candidate = candidate;
+
+            if (!cached.satisfied) [[likely]]
+                return check.lowestWheel;
         }
         [[unlikely]]
-        return true;
+        return {};
     }
 
 }
@@ -9,18 +9,63 @@ namespace epuzzle::details::bruteforce
     //   These checks will be excluded from the subsequent main check (via isSolutionValid) as unnecessary.
     // * If prefiltering disabled: the main check stage (via isSolutionValid) will involve a full enumeration
     //   and all checks of all possible solution candidates (mode for diagnostics, etc).
+    // Each main check knows its lowest wheel (attribute type): a failure is the same for all states of the lower wheels,
+    // so the cursor can skip them (see failedWheel, SearchSpaceCursor::skipTo).
+    // Incremental revalidation: a check result is reused from the previous candidate if the cursor move did not change
+    // its wheels, or changed only values of the first wheel the check does not depend on (see SearchSpaceCursor::changedWheels).
+    // Adaptive order: each thread counts rejections of the checks and re-ranks the checks of one lowest wheel by cost / rejection
+    // probability (the most selective cheap checks first) when it takes a new chunk, out of the hot path (see rerank).
+    // The state is thread-local, no synchronization.
     class Validator
     {
     public:
         Validator(size_t attrTypeCount, const std::vector<ConstraintModel>&, bool needPrefiltering);
 
         bool isAttributeAssignmentValid(AttributeTypeID, const AttributeAssignment&) const;
+        // The same prefilter as value domains: possible owners of the value (bit N - PersonID{N}), see SearchSpace::AllowedOwners
+        std::uint64_t allowedOwners(AttributeTypeID, AttributeValueID) const;
 
         bool isSolutionValid(const SearchSpaceCursor&) const;
 
+        // Check results of the previous candidate and the check order statistics. One per thread,
+        // consecutive candidates must be of one cursor or be the first of it.
+        class Cache
+        {
+            friend Validator;
+        public:
+            std::uint64_t evaluations() const { return m_evaluations; } // checks evaluated (not reused), for diagnostics
+            const std::vector<std::uint32_t>& order() const { return m_order; } // check indexes in the order of evaluation
+
+        private:
+            struct Entry
+            {
+                std::uint64_t candidate = 0; // number of the candidate the result belongs to
+                bool satisfied = false;
+                std::uint32_t evaluated = 0; // since the last re-ranking (with decay)
+                std::uint32_t rejected = 0;
+            };
+            std::vector<Entry> m_entries; // index: check
+            std::vector<std::uint32_t> m_order; // check indexes in the order of evaluation
+            std::uint64_t m_candidate = 1;
+            std::uint64_t m_evaluations = 0;
+        };
+        Cache createCache() const;
+
+        // Lowest wheel of the first failed check, none if the candidate is valid
+        std::optional<AttributeTypeID> failedWheel(const SearchSpaceCursor&, Cache&) const;
+        // Re-rank the checks by the statistics of the cache. Between the cursors (chunks): the order is stable inside a chunk.
+        void rerank(Cache&) const;
+
     private:
+        struct Check
+        {
+            std::unique_ptr<ConstraintChecker> checker;
+            AttributeTypeID lowestWheel;
+            std::uint64_t lowestWheelValues; // values of the lowest wheel the result depends on (bit N - AttributeValueID{N})
+        };
+
         utils::IndexedVector<AttributeTypeID, std::vector<PersonProperty>> m_prefilters;
-        std::vector<std::unique_ptr<ConstraintChecker>> m_constraintCheckers;
+        std::vector<Check> m_checks;
     };
 
 }
@@ -0,0 +1,106 @@
+#include "WheelCache.h"
+
+namespace epuzzle::details::bruteforce
+{
+
+    Wheel::Wheel(std::vector<AttributeAssignment> wheelPermutations)
+        : permutations(std::move(wheelPermutations))
+    {
+        if (!permutations.empty() && permutations.front().size() <= maxPackedPersons)
+        {
+            packed.reserve(permutations.size());
+            std::ranges::transform(permutations, std::back_inserter(packed), [](const AttributeAssignment& assignment) { return pack(assignment); });
+        }
+    }
+
+    size_t Wheel::memoryBytes() const
+    {
+        const size_t personCount = permutations.empty() ? 0 : permutations.front().size();
+        return permutations.size() * (sizeof(AttributeAssignment) + personCount * sizeof(PersonID)) + packed.size() * sizeof(PackedAssignment);
+    }
+
+    WheelCache& WheelCache::instance()
+    {
+        static WheelCache cache;
+        return cache;
+    }
+
+    SharedWheel WheelCache::find(const WheelSpec& spec, size_t count)
+    {
+        const std::lock_guard lock{ m_guard };
+        const auto found = m_entries.find(spec);
+        if (found == m_entries.end())
+        {
+            ++m_stats.misses;
+            m_stats.hits += count - 1;
+            return {};
+        }
+        m_stats.hits += count;
+        m_recent.splice(m_recent.begin(), m_recent, found->second.recent);
+        return found->second.wheel;
+    }
+
+    SharedWheel WheelCache::add(const WheelSpec& spec, std::vector<AttributeAssignment> permutations)
+    {
+        auto wheel = std::make_shared<const Wheel>(std::move(permutations)); // packed outside the lock
+        const std::lock_guard lock{ m_guard };
+        const auto [found, added] = m_entries.try_emplace(spec, Entry{ .wheel = wheel, .recent = {} });
+        if (!added)
+            return found->second.wheel;
+
+        found->second.recent = m_recent.insert(m_recent.begin(), &found->first);
+        ++m_stats.wheels;
+        m_stats.bytes += wheel->memoryBytes();
+        evict();
+        return wheel;
+    }
+
+    void WheelCache::setCapacity(size_t bytes)
+    {
+        const std::lock_guard lock{ m_guard };
+        m_capacity = bytes;
+        evict();
+    }
+
+    void WheelCache::clear()
+    {
+        const std::lock_guard lock{ m_guard };
+        m_recent.clear();
+        m_entries.clear();
+        m_stats = {};
+    }
+
+    void WheelCache::evict()
+    {
+        while (m_stats.bytes > m_capacity && !m_recent.empty())
+        {
+            const auto entry = m_entries.find(*m_recent.back());
+            m_stats.bytes -= entry->second.wheel->memoryBytes();
+            --m_stats.wheels;
+            ++m_stats.evictions;
+            m_recent.pop_back();
+            m_entries.erase(entry);
+        }
+    }
+
+    WheelCache::Stats WheelCache::stats() const
+    {
+        const std::lock_guard lock{ m_guard };
+        return m_stats;
+    }
+
+    std::string WheelCache::statsText() const
+    {
+        const auto current = stats();
+        const auto lookups = current.hits + current.misses;
+        constexpr size_t kilobyte = 1024;
+        std::string text = std::to_string(current.hits) + " hits, " + std::to_string(current.misses) + " misses";
+        if (lookups > 0)
+            text += " (" + std::to_string(current.hits * 100 / lookups) + "% hit rate)";
+        text += ", " + std::to_string(current.wheels) + " wheels, " + std::to_string((current.bytes + kilobyte - 1) / kilobyte) + " KB";
+        if (current.evictions > 0)
+            text += ", " + std::to_string(current.evictions) + " evicted";
+        return text;
+    }
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include "epuzzle/SolverConfig.h"
+#include "utils/platform/LargePages.h"
+#include "SearchSpaceCursor.h"
+
+namespace epuzzle::details::bruteforce
+{
+
+    // Canonical description of a wheel: the wheels of equal specs are equal, whatever puzzle or attribute type they are of.
+    // The prefilter of a wheel is its value domains (single-type facts and presolve, see Validator::allowedOwners) and the symmetry
+    // breaking order (see InterchangeableValues), so most wheels of one persons count are the same in a batch of puzzles.
+    struct WheelSpec
+    {
+        size_t personCount = 0; // = values count, <= 64
+        SolverConfig::BruteForceConfig::WheelOrder order = SolverConfig::BruteForceConfig::WheelOrder::Lexicographic;
+        std::vector<std::uint64_t> owners; // possible owners of each value (bit N - PersonID{N}), only the persons bits
+        std::vector<std::vector<AttributeValueID>> ascendingOwners; // sorted groups of values (sorted) whose owners are ascending
+
+        auto operator<=>(const WheelSpec&) const = default;
+    };
+
+    // The permutations of a wheel and the same packed (empty if persons count > maxPackedPersons). Immutable: shared read-only.
+    struct Wheel
+    {
+        std::vector<AttributeAssignment> permutations;
+        std::pmr::vector<PackedAssignment> packed{ platform::largePages() };
+
+        explicit Wheel(std::vector<AttributeAssignment>);
+        size_t memoryBytes() const;
+    };
+    using SharedWheel = std::shared_ptr<const Wheel>;
+
+    // Process-wide cache of generated wheels: identical wheels are generated once and shared by all the search spaces (the
+    // references are counted by SharedWheel). The least recently used wheels are dropped over the memory cap; a dropped wheel
+    // lives while some search space uses it. Thread-safe.
+    class WheelCache
+    {
+    public:
+        static constexpr size_t defaultCapacity = size_t{ 512 } * 1024 * 1024; // bytes
+
+        static WheelCache& instance();
+
+        // count - wheels of the spec needed by the caller: if missed, one is generated (a miss) and shared by the others (hits)
+        SharedWheel find(const WheelSpec&, size_t count = 1);
+        // The cached wheel if another thread has added the same spec meanwhile
+        SharedWheel add(const WheelSpec&, std::vector<AttributeAssignment> permutations);
+
+        void setCapacity(size_t bytes);
+        void clear(); // the statistics too
+
+        struct Stats
+        {
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+            std::uint64_t evictions = 0;
+            size_t wheels = 0;
+            size_t bytes = 0;
+        };
+        Stats stats() const;
+        std::string statsText() const; // for solver statistics
+
+    private:
+        WheelCache() = default;
+        void evict(); // under the lock
+
+    private:
+        struct Entry
+        {
+            SharedWheel wheel;
+            std::list<const WheelSpec*>::iterator recent;
+        };
+
+        mutable std::mutex m_guard;
+        std::map<WheelSpec, Entry> m_entries;
+        std::list<const WheelSpec*> m_recent; // keys of m_entries, the most recently used first
+        size_t m_capacity = defaultCapacity;
+        Stats m_stats;
+    };
+
+}
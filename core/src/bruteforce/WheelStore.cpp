@@ -0,0 +1,48 @@
+#include "WheelStore.h"
+
+namespace epuzzle::details::bruteforce
+{
+
+    std::uint64_t WheelStore::key(const PuzzleModel& model)
+    {
+        std::ostringstream text;
+        text << model.definition(); // the names; sub-models and pivoted models have no constraints there
+        auto printComparable = [&text](const std::variant<PersonID, Attribute>& comparable)
+            {
+                if (const auto* person = std::get_if<PersonID>(&comparable))
+                    text << " p" << person->value();
+                else
+                    text << " a" << std::get<Attribute>(comparable).typeId.value() << "." << std::get<Attribute>(comparable).valueId.value();
+            };
+        for (const auto& constraint : model.constraints())
+        {
+            text << "\n";
+            std::visit(utils::overloaded
+                {
+                    [&text](const PersonProperty& c) { text << "PP " << c.person.value() << " " << c.attr.typeId.value() << "." << c.attr.valueId.value() << " " << c.negate; },
+                    [&text](const SameOwner& c) { text << "SO " << c.first.typeId.value() << "." << c.first.valueId.value() << " " << c.second.typeId.value() << "." << c.second.valueId.value() << " " << c.secondNegate; },
+                    [&text, printComparable](const PositionComparison& c)
+                    {
+                        text << "PC";
+                        printComparable(c.first);
+                        printComparable(c.second);
+                        text << " " << c.compareByType.value() << " " << static_cast<int>(c.relation);
+                    },
+                }, constraint);
+        }
+        return utils::fnv1a(text.str());
+    }
+
+    const SearchSpace::Wheels* WheelStore::find(std::uint64_t key) const
+    {
+        const auto found = m_wheels.find(key);
+        return (found != m_wheels.end()) ? &found->second : nullptr;
+    }
+
+    void WheelStore::add(std::uint64_t key, SearchSpace::Wheels wheels)
+    {
+        ENSURE(m_recording, "The wheel store is read-only");
+        m_wheels.insert_or_assign(key, std::move(wheels));
+    }
+
+}
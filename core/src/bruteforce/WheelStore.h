@@ -0,0 +1,34 @@
+#pragma once
+#include "PuzzleModel.h"
+#include "SearchSpace.h"
+
+namespace epuzzle::details::bruteforce
+{
+
+    // Prebuilt wheels of the solver contexts of one puzzle and config (see CompiledPuzzle). A context takes its wheels from the store
+    // instead of generating them, if the store has the wheels of its model (the pivoted model and the parts of a decomposed puzzle
+    // are different models). A recording store (compilation) gets the wheels generated by the contexts instead.
+    class WheelStore
+    {
+    public:
+        WheelStore() = default; // recording
+        explicit WheelStore(std::map<std::uint64_t, SearchSpace::Wheels> prebuilt)
+            : m_recording(false)
+            , m_wheels(std::move(prebuilt))
+        {
+        }
+
+        // Identifies the model: the persons, the attributes and the indexed constraints (including derived ones)
+        static std::uint64_t key(const PuzzleModel&);
+
+        const SearchSpace::Wheels* find(std::uint64_t key) const;
+        bool recording() const { return m_recording; }
+        void add(std::uint64_t key, SearchSpace::Wheels);
+        const std::map<std::uint64_t, SearchSpace::Wheels>& wheels() const { return m_wheels; }
+
+    private:
+        const bool m_recording = true;
+        std::map<std::uint64_t, SearchSpace::Wheels> m_wheels;
+    };
+
+}
@@ -0,0 +1,221 @@
+#include "epuzzle/Exceptions.h"
+#include "epuzzle/SolverCompiler.h"
+#include "bruteforce/SolverContext.h"
+
+namespace epuzzle
+{
+namespace
+{
+    using namespace details;
+
+    // Wheels nesting order (outer first): greedily, the wheel completing most constraints, then the smallest one.
+    // So the constraints prune as early as possible.
+    std::vector<AttributeTypeID> loopOrder(const PuzzleModel& model, const bruteforce::SearchSpace& space)
+    {
+        std::vector<std::vector<AttributeTypeID>> involved;
+        for (const auto& constraint : model.constraints())
+            involved.push_back(involvedAttrTypes(constraint));
+
+        std::vector<AttributeTypeID> order;
+        std::vector<bool> bound(model.attrTypeCount());
+        while (order.size() < model.attrTypeCount())
+        {
+            std::optional<AttributeTypeID> best;
+            std::pair<size_t, size_t> bestScore; // completed constraints (more is better), wheel size (less is better)
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ model.attrTypeCount() }; ++typeId)
+            {
+                if (bound[typeId.value()])
+                    continue;
+                const auto completed = static_cast<size_t>(std::ranges::count_if(involved, [&bound, typeId](const auto& types)
+                    {
+                        return std::ranges::find(types, typeId) != types.end()
+                            && std::ranges::all_of(types, [&bound, typeId](AttributeTypeID other) { return other == typeId || bound[other.value()]; });
+                    }));
+                const std::pair score{ completed, space.wheelSize(typeId) };
+                if (!best || score.first > bestScore.first || (score.first == bestScore.first && score.second < bestScore.second))
+                {
+                    best = typeId;
+                    bestScore = score;
+                }
+            }
+            bound[best->value()] = true;
+            order.push_back(*best);
+        }
+        return order;
+    }
+
+    // Inline expressions over the packed wheel variables `w<type>` (see bruteforce::PackedAssignment)
+    std::string ownerExpr(const Attribute& attr)
+    {
+        return "owner(w" + std::to_string(attr.typeId.value()) + ", " + std::to_string(attr.valueId.value()) + ")";
+    }
+
+    std::string positionExpr(const std::variant<PersonID, Attribute>& person, AttributeTypeID compareByType)
+    {
+        const auto* personId = std::get_if<PersonID>(&person);
+        return "position(w" + std::to_string(compareByType.value()) + ", "
+            + (personId ? std::to_string(personId->value()) : ownerExpr(std::get<Attribute>(person))) + ")";
+    }
+
+    std::string checkExpr(const ConstraintModel& constraint)
+    {
+        return std::visit(utils::overloaded
+            {
+                [](const PersonProperty& property)
+                {
+                    return ownerExpr(property.attr) + (property.negate ? " != " : " == ") + std::to_string(property.person.value()) + "u";
+                },
+                [](const SameOwner& sameOwner)
+                {
+                    return ownerExpr(sameOwner.first) + (sameOwner.secondNegate ? " != " : " == ") + ownerExpr(sameOwner.second);
+                },
+                [](const PositionComparison& comparison)
+                {
+                    const auto pos1 = positionExpr(comparison.first, comparison.compareByType);
+                    const auto pos2 = positionExpr(comparison.second, comparison.compareByType);
+                    using Relation = PuzzleDefinition::Comparison::Relation;
+                    switch (comparison.relation)
+                    {
+                    case Relation::ImmediateLeft:   return pos2 + " - " + pos1 + " == 1";
+                    case Relation::ImmediateRight:  return pos1 + " - " + pos2 + " == 1";
+                    case Relation::Adjacent:        return "adjacent(" + pos1 + ", " + pos2 + ")";
+                    case Relation::Before:          return pos1 + " < " + pos2;
+                    case Relation::After:           return pos1 + " > " + pos2;
+                    default: ENSURE(false, "Unexpected PositionComparison::relation: (int)" << static_cast<int>(comparison.relation));
+                    };
+                }
+            }, constraint);
+    }
+
+    size_t complexity(const ConstraintModel& constraint)
+    {
+        return bruteforce::ConstraintChecker::create(constraint)->complexity();
+    }
+
+    std::string quoted(std::string_view text)
+    {
+        std::string result = "\"";
+        for (const char ch : text)
+        {
+            if (ch == '"' || ch == '\\')
+                result += '\\';
+            result += ch;
+        }
+        return result + "\"";
+    }
+
+} // namespace
+
+    void generateSolverSource(PuzzleDefinition puzzleDefinition, std::ostream& os)
+    {
+        normalize(puzzleDefinition);
+        validate(puzzleDefinition);
+        if (puzzleDefinition.persons.size() > bruteforce::maxPackedPersons)
+        {
+            throw SolverConfigError("Ahead-of-time compilation supports up to " + std::to_string(bruteforce::maxPackedPersons)
+                + " persons, the puzzle has " + std::to_string(puzzleDefinition.persons.size()));
+        }
+
+        // Wheels are generated as for the bruteforce: prefiltered by the single person facts and narrowed by presolve.
+        // No symmetry breaking: the program prints all solutions.
+        const bruteforce::SolverContext ctx{ PuzzleModel{ std::move(puzzleDefinition) },
+            SolverConfig::BruteForceConfig{ .prefilter = true, .presolve = true, .breakSymmetry = false } };
+        const auto& model = ctx.puzzleModel();
+        const auto& space = ctx.searchSpace();
+        const auto personCount = model.personCount();
+        const auto attrTypeCount = model.attrTypeCount();
+        const auto order = loopOrder(model, space);
+
+        // Constraints by nesting level: checked as soon as all their wheels are bound, simplest first.
+        // Single person facts are already applied to the wheels.
+        std::vector<std::vector<const ConstraintModel*>> levelChecks(attrTypeCount);
+        for (const auto& constraint : model.constraints())
+        {
+            if (std::holds_alternative<PersonProperty>(constraint))
+                continue;
+            size_t level = 0;
+            for (const auto typeId : involvedAttrTypes(constraint))
+                level = std::max<size_t>(level, std::ranges::find(order, typeId) - order.begin());
+            levelChecks[level].push_back(&constraint);
+        }
+        for (auto& checks : levelChecks)
+            std::ranges::stable_sort(checks, {}, [](const ConstraintModel* constraint) { return complexity(*constraint); });
+
+        os << "// CAUTION! Automatically generated by epuzzle-compile - do not edit manually!\n"
+            << "// Standalone solver of one puzzle: " << personCount << " persons, " << attrTypeCount << " attribute types, "
+            << model.constraints().size() << " constraints, " << space.totalSolutionCandidates() << " solution candidates.\n"
+            << "#include <array>\n#include <cstdint>\n#include <cstdio>\n\n"
+            << "namespace\n{\n"
+            << "    constexpr unsigned personCount = " << personCount << ";\n\n"
+            << "    constexpr unsigned owner(std::uint64_t word, unsigned value) { return (word >> (4 * value)) & 0xF; }\n"
+            << "    constexpr int position(std::uint64_t word, unsigned person) { return static_cast<int>((word >> (32 + 4 * person)) & 0xF); }\n"
+            << "    constexpr bool adjacent(int pos1, int pos2) { return pos1 - pos2 == 1 || pos2 - pos1 == 1; }\n\n"
+            << "    constexpr std::array<const char*, personCount> personNames{";
+        for (auto personId = PersonID{ 0 }; personId < PersonID{ personCount }; ++personId)
+            os << (personId.value() == 0 ? " " : ", ") << quoted(model.personName(personId));
+        os << " };\n\n";
+
+        os << "    // Wheels: allowed permutations of each attribute type. Packed: low half - owner of each value (4 bits per value),\n"
+            << "    // high half - position (value) of each person.\n";
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ attrTypeCount }; ++typeId)
+        {
+            const auto& wheel = space.wheel(typeId);
+            os << "    constexpr const char* typeName" << typeId.value() << " = " << quoted(model.attrTypeName(typeId)) << ";\n"
+                << "    constexpr std::array<const char*, personCount> valueNames" << typeId.value() << "{";
+            for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ personCount }; ++valueId)
+                os << (valueId.value() == 0 ? " " : ", ") << quoted(model.attrValueName(typeId, valueId));
+            os << " };\n"
+                << "    constexpr std::array<std::uint64_t, " << wheel.size() << "> wheel" << typeId.value() << "{";
+            for (size_t position = 0; position < wheel.size(); ++position)
+                os << (position % 8 == 0 ? "\n        " : " ") << "0x" << std::hex << bruteforce::pack(wheel[position]) << std::dec << "ull,";
+            os << "\n    };\n\n";
+        }
+
+        os << "    void printAttribute(const char* typeName, const std::array<const char*, personCount>& valueNames, std::uint64_t word)\n"
+            << "    {\n"
+            << "        std::printf(\"  %s:\", typeName);\n"
+            << "        for (unsigned person = 0; person < personCount; ++person)\n"
+            << "            std::printf(\" %s\", valueNames[position(word, person)]);\n"
+            << "        std::printf(\"\\n\");\n"
+            << "    }\n\n";
+
+        os << "    void printSolution(std::uint64_t number";
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ attrTypeCount }; ++typeId)
+            os << ", std::uint64_t w" << typeId.value();
+        os << ")\n    {\n"
+            << "        std::printf(\"Solution #%llu:\\n  person:\", static_cast<unsigned long long>(number));\n"
+            << "        for (const auto* name : personNames)\n"
+            << "            std::printf(\" %s\", name);\n"
+            << "        std::printf(\"\\n\");\n";
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ attrTypeCount }; ++typeId)
+            os << "        printAttribute(typeName" << typeId.value() << ", valueNames" << typeId.value() << ", w" << typeId.value() << ");\n";
+        os << "    }\n"
+            << "} // namespace\n\n";
+
+        os << "int main()\n{\n"
+            << "    std::uint64_t count = 0;\n";
+        std::string indent = "    ";
+        for (size_t level = 0; level < order.size(); ++level)
+        {
+            const auto typeIndex = std::to_string(order[level].value());
+            os << indent << "for (const std::uint64_t w" << typeIndex << " : wheel" << typeIndex << ")\n"
+                << indent << "{\n";
+            indent += "    ";
+            for (const auto* constraint : levelChecks[level])
+                os << indent << "if (!(" << checkExpr(*constraint) << "))\n" << indent << "    continue;\n";
+        }
+        os << indent << "printSolution(++count";
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ attrTypeCount }; ++typeId)
+            os << ", w" << typeId.value();
+        os << ");\n";
+        for (size_t level = 0; level < order.size(); ++level)
+        {
+            indent.resize(indent.size() - 4);
+            os << indent << "}\n";
+        }
+        os << "    std::printf(\"Solutions found: %llu\\n\", static_cast<unsigned long long>(count));\n"
+            << "    return 0;\n"
+            << "}\n";
+    }
+
+}
@@ -0,0 +1,340 @@
+#include "SolutionModel.h"
+#include "CountingSolver.h"
+
+namespace epuzzle::details::counting
+{
+namespace
+{
+    using presolve::Domains;
+    using presolve::PersonSet;
+
+    std::uint64_t checkedAdd(std::uint64_t lhs, std::uint64_t rhs)
+    {
+        ENSURE(lhs <= std::numeric_limits<std::uint64_t>::max() - rhs, "Too much solutions count for using uint64!");
+        return lhs + rhs;
+    }
+
+    std::uint64_t checkedMultiply(std::uint64_t lhs, std::uint64_t rhs)
+    {
+        ENSURE(rhs == 0 || lhs <= std::numeric_limits<std::uint64_t>::max() / rhs, "Too much solutions count for using uint64!");
+        return lhs * rhs;
+    }
+
+    struct Cell
+    {
+        AttributeTypeID typeId;
+        AttributeValueID valueId;
+    };
+
+    // All types, the most constrained first: on equal domain sizes branching prefers them (their decisions propagate further)
+    std::vector<AttributeTypeID> typesByDegree(const PuzzleModel& model)
+    {
+        utils::IndexedVector<AttributeTypeID, size_t> degree(model.attrTypeCount());
+        for (const auto& constraint : model.constraints())
+        {
+            for (const auto typeId : involvedAttrTypes(constraint))
+                ++degree[typeId];
+        }
+        std::vector<AttributeTypeID> types(model.attrTypeCount());
+        std::iota(types.begin(), types.end(), AttributeTypeID{ 0 });
+        std::ranges::stable_sort(types, std::greater{}, [&degree](AttributeTypeID typeId) { return degree[typeId]; });
+        return types;
+    }
+
+    // Undecided cell with the smallest domain (fail-first) among the given types; ties are resolved by the types order
+    std::optional<Cell> branchingCell(const Domains& domains, const std::vector<AttributeTypeID>& types)
+    {
+        std::optional<Cell> best;
+        int bestSize = std::numeric_limits<int>::max();
+        for (const auto typeId : types)
+        {
+            for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ domains.personCount() }; ++valueId)
+            {
+                const int size = std::popcount(domains.owners(typeId, valueId));
+                if (size > 1 && size < bestSize)
+                {
+                    bestSize = size;
+                    best = Cell{ .typeId = typeId, .valueId = valueId };
+                }
+            }
+        }
+        return best;
+    }
+
+    SolutionModel toSolutionModel(const Domains& domains)
+    {
+        SolutionModel solution{ domains.attrTypeCount() };
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ domains.attrTypeCount() }; ++typeId)
+        {
+            AttributeAssignment assignment(domains.personCount());
+            for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ domains.personCount() }; ++valueId)
+                assignment[valueId] = PersonID{ static_cast<size_t>(std::countr_zero(domains.owners(typeId, valueId))) };
+            solution.setAttributeAssignment(typeId, std::move(assignment));
+        }
+        return solution;
+    }
+
+    // Periodically reports progress (total = 1, current = 0 until finished) and detects user cancel
+    class CancelChecker
+    {
+    public:
+        explicit CancelChecker(const Solver::SolveOptions& opts)
+            : m_opts(opts)
+            , m_lastTime(std::chrono::steady_clock::now())
+        {
+        }
+
+        bool canceled()
+        {
+            constexpr std::uint64_t clockCheckInterval = 1024;
+            if (!m_canceled && ++m_nodes % clockCheckInterval == 0 && std::chrono::steady_clock::now() - m_lastTime >= m_opts.progressInterval)
+            {
+                m_lastTime = std::chrono::steady_clock::now();
+                m_canceled = !m_opts.progressCallback(1, 0);
+            }
+            return m_canceled;
+        }
+
+    private:
+        const Solver::SolveOptions& m_opts;
+        std::chrono::steady_clock::time_point m_lastTime;
+        std::uint64_t m_nodes = 0;
+        bool m_canceled = false;
+    };
+
+    // -------------------------------- class ComponentCounter ------------------------------------------------
+
+    class ComponentCounter
+    {
+    public:
+        ComponentCounter(const PuzzleModel& model, const presolve::Propagator& propagator, CancelChecker& cancelChecker)
+            : m_propagator(propagator)
+            , m_cancelChecker(cancelChecker)
+            , m_referenced(model.attrTypeCount())
+            , m_neighbors(model.attrTypeCount())
+        {
+            for (auto& values : m_referenced)
+                values.resize(model.personCount(), false);
+
+            auto reference = [this](const Attribute& attr) { m_referenced[attr.typeId][attr.valueId.value()] = true; };
+            for (const auto& constraint : model.constraints())
+            {
+                std::visit(utils::overloaded
+                    {
+                        [reference](const PersonProperty& property) { reference(property.attr); },
+                        [reference](const SameOwner& sameOwner) { reference(sameOwner.first); reference(sameOwner.second); },
+                        [this, reference](const PositionComparison& comparison)
+                        {
+                            for (const auto* comparable : { &comparison.first, &comparison.second })
+                            {
+                                if (const auto* attr = std::get_if<Attribute>(comparable))
+                                    reference(*attr);
+                            }
+                            auto& positions = m_referenced[comparison.compareByType];
+                            std::fill(positions.begin(), positions.end(), true); // positions of all values matter
+                        },
+                    }, constraint);
+
+                m_constraintTypes.push_back(involvedAttrTypes(constraint));
+                for (const auto typeId : m_constraintTypes.back())
+                    std::ranges::copy(m_constraintTypes.back(), std::back_inserter(m_neighbors[typeId]));
+            }
+            for (auto& neighbors : m_neighbors)
+            {
+                std::ranges::sort(neighbors);
+                const auto duplicates = std::ranges::unique(neighbors);
+                neighbors.erase(duplicates.begin(), duplicates.end());
+            }
+        }
+
+        // Count of solutions of the propagated domains restricted to the types, if the types are not linked with other undecided types
+        std::uint64_t countTypes(const Domains& domains, const std::vector<AttributeTypeID>& types)
+        {
+            std::uint64_t count = 1;
+            for (const auto& component : components(domains, types))
+            {
+                count = checkedMultiply(count, countComponent(domains, component));
+                if (count == 0)
+                    break;
+            }
+            return count;
+        }
+
+    private:
+        // Undecided types of the set, grouped by constraints linking them
+        std::vector<std::vector<AttributeTypeID>> components(const Domains& domains, const std::vector<AttributeTypeID>& types) const
+        {
+            std::vector<AttributeTypeID> undecided;
+            std::ranges::copy_if(types, std::back_inserter(undecided), [&domains](AttributeTypeID typeId) { return !domains.isFixed(typeId); });
+
+            // Union-find over undecided types
+            utils::IndexedVector<AttributeTypeID, AttributeTypeID> parent(domains.attrTypeCount());
+            std::iota(parent.begin(), parent.end(), AttributeTypeID{ 0 });
+            auto root = [&parent](AttributeTypeID typeId)
+                {
+                    while (parent[typeId] != typeId)
+                        typeId = parent[typeId] = parent[parent[typeId]];
+                    return typeId;
+                };
+
+            for (const auto& constraintTypes : m_constraintTypes)
+            {
+                std::optional<AttributeTypeID> first;
+                for (const auto typeId : constraintTypes)
+                {
+                    if (domains.isFixed(typeId))
+                        continue;
+                    if (first)
+                        parent[root(typeId)] = root(*first);
+                    else
+                        first = typeId;
+                }
+            }
+
+            std::map<AttributeTypeID, std::vector<AttributeTypeID>> grouped;
+            for (const auto typeId : undecided)
+                grouped[root(typeId)].push_back(typeId);
+
+            std::vector<std::vector<AttributeTypeID>> result;
+            result.reserve(grouped.size());
+            for (auto& [rootId, component] : grouped)
+                result.push_back(std::move(component));
+            return result;
+        }
+
+        // Residual subproblem signature: component domains and fixed neighbor types domains.
+        // A decided cell that no constraint references affects the rest only via bijection (already reflected in the other domains),
+        // so it is encoded as 0: paths that decide such cells differently share one cache entry.
+        std::vector<std::uint64_t> signature(const Domains& domains, const std::vector<AttributeTypeID>& component) const
+        {
+            std::vector<AttributeTypeID> types = component;
+            for (const auto typeId : component)
+            {
+                std::ranges::copy_if(m_neighbors[typeId], std::back_inserter(types),
+                    [&domains](AttributeTypeID neighbor) { return domains.isFixed(neighbor); });
+            }
+            std::ranges::sort(types);
+            const auto duplicates = std::ranges::unique(types);
+            types.erase(duplicates.begin(), duplicates.end());
+
+            std::vector<std::uint64_t> key;
+            key.reserve(types.size() * (1 + domains.personCount()));
+            for (const auto typeId : types)
+            {
+                key.push_back(typeId.value());
+                for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ domains.personCount() }; ++valueId)
+                {
+                    const bool relevant = m_referenced[typeId][valueId.value()] || !domains.isFixed(typeId, valueId);
+                    key.push_back(relevant ? domains.owners(typeId, valueId) : 0);
+                }
+            }
+            return key;
+        }
+
+        std::uint64_t countComponent(const Domains& domains, const std::vector<AttributeTypeID>& component)
+        {
+            auto key = signature(domains, component);
+            if (const auto cit = m_cache.find(key); cit != m_cache.cend())
+                return cit->second;
+
+            const auto cell = branchingCell(domains, component);
+            ENSURE(cell, "Undecided component must have an undecided cell!");
+
+            std::uint64_t count = 0;
+            presolve::forEachBit(domains.owners(cell->typeId, cell->valueId), [&](size_t person)
+                {
+                    if (m_cancelChecker.canceled())
+                        return;
+                    auto branch = domains;
+                    branch.restrict(cell->typeId, cell->valueId, Domains::single(PersonID{ person }));
+                    if (m_propagator.propagate(branch))
+                        count = checkedAdd(count, countTypes(branch, component));
+                });
+
+            if (!m_cancelChecker.canceled())
+                m_cache.emplace(std::move(key), count);
+            return count;
+        }
+
+    private:
+        struct SignatureHash
+        {
+            size_t operator()(const std::vector<std::uint64_t>& key) const noexcept
+            {
+                std::uint64_t hash = 14695981039346656037ull; // FNV-1a over words
+                for (const auto word : key)
+                    hash = (hash ^ word) * 1099511628211ull;
+                return static_cast<size_t>(hash);
+            }
+        };
+
+        const presolve::Propagator& m_propagator;
+        CancelChecker& m_cancelChecker;
+        utils::IndexedVector<AttributeTypeID, std::vector<bool>> m_referenced; // index: value
+        utils::IndexedVector<AttributeTypeID, std::vector<AttributeTypeID>> m_neighbors; // types sharing a constraint (incl. itself)
+        std::vector<std::vector<AttributeTypeID>> m_constraintTypes; // index: constraint
+        std::unordered_map<std::vector<std::uint64_t>, std::uint64_t, SignatureHash> m_cache;
+    };
+
+} // namespace
+
+    CountingSolver::CountingSolver(PuzzleModel&& puzzleModel)
+        : m_puzzleModel(std::move(puzzleModel))
+        , m_propagator(m_puzzleModel)
+    {
+    }
+
+    std::vector<PuzzleSolution> CountingSolver::solve(const SolveOptions& opts)
+    {
+        if (!opts.progressCallback(1, 0))
+            return {};
+
+        std::vector<PuzzleSolution> solutions;
+        CancelChecker cancelChecker{ opts };
+        const auto allTypes = typesByDegree(m_puzzleModel);
+
+        std::function<void(Domains&)> search = [&](Domains& domains)
+            {
+                if (cancelChecker.canceled() || !m_propagator.propagate(domains))
+                    return;
+
+                const auto cell = branchingCell(domains, allTypes);
+                if (!cell) // all decided: complete propagation proves the solution
+                {
+                    solutions.push_back(toSolutionModel(domains).toPuzzleSolution(m_puzzleModel));
+                    return;
+                }
+                presolve::forEachBit(domains.owners(cell->typeId, cell->valueId), [&](size_t person)
+                    {
+                        auto branch = domains;
+                        branch.restrict(cell->typeId, cell->valueId, Domains::single(PersonID{ person }));
+                        search(branch);
+                    });
+            };
+        auto domains = m_propagator.initialDomains();
+        search(domains);
+
+        if (!cancelChecker.canceled())
+            opts.progressCallback(1, 1);
+        return solutions;
+    }
+
+    std::uint64_t CountingSolver::countSolutions(const SolveOptions& opts)
+    {
+        if (!opts.progressCallback(1, 0))
+            return 0;
+
+        CancelChecker cancelChecker{ opts };
+        ComponentCounter counter{ m_puzzleModel, m_propagator, cancelChecker };
+        const auto allTypes = typesByDegree(m_puzzleModel);
+
+        auto domains = m_propagator.initialDomains();
+        const auto count = m_propagator.propagate(domains) ? counter.countTypes(domains, allTypes) : 0;
+        if (cancelChecker.canceled())
+            return 0;
+
+        opts.progressCallback(1, 1);
+        return count;
+    }
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "epuzzle/Solver.h"
+#include "PuzzleModel.h"
+#include "presolve/Propagator.h"
+
+namespace epuzzle::details::counting
+{
+    // Exact solver over person x value domains: branching on the smallest undecided domain + propagation after each decision.
+    // solve() enumerates solutions by depth-first search.
+    // countSolutions() counts them without enumeration, in the style of #SAT model counters:
+    // * the undecided attribute types are split into components not linked by any constraint, their counts are multiplied;
+    // * component counts are cached by domain signature, so equal residual subproblems reached by different paths are counted once.
+    class CountingSolver final : public Solver
+    {
+    public:
+        explicit CountingSolver(PuzzleModel&&);
+
+        std::vector<PuzzleSolution> solve(const SolveOptions&) override;
+        std::uint64_t countSolutions(const SolveOptions&) override;
+
+    private:
+        const PuzzleModel m_puzzleModel;
+        const presolve::Propagator m_propagator;
+    };
+
+}
@@ -0,0 +1,333 @@
+#include "JoinSolver.h"
+
+namespace epuzzle::details::join
+{
+namespace
+{
+    using RowIndex = std::uint32_t;
+    using Wheel = std::vector<AttributeAssignment>;
+
+    // -------------------------------- class TupleView ------------------------------------------------
+
+    // Current row of the join: one wheel row per bound attribute type.
+    // It is exposed as a cursor, so constraints are evaluated by the same checkers as in bruteforce.
+    class TupleView final : public bruteforce::SearchSpaceCursor
+    {
+    public:
+        explicit TupleView(const bruteforce::SearchSpace& space, size_t attrTypeCount)
+            : m_wheels(attrTypeCount)
+            , m_rows(attrTypeCount)
+        {
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ attrTypeCount }; ++typeId)
+                m_wheels[typeId] = &space.wheel(typeId);
+        }
+
+        void setRow(AttributeTypeID typeId, RowIndex row)
+        {
+            m_rows[typeId] = row;
+        }
+
+        bool moveNext() override
+        {
+            return false; // the rows are set by setRow() only
+        }
+
+        PersonID ownerOf(AttributeTypeID typeId, AttributeValueID valueId) const override
+        {
+            return assignment(typeId)[valueId];
+        }
+
+        size_t personPosition(PersonID personId, AttributeTypeID typeId) const override
+        {
+            const auto& owners = assignment(typeId);
+            return std::ranges::find(owners, personId) - owners.cbegin();
+        }
+
+        SolutionModel getSolutionModel() const override
+        {
+            SolutionModel solution{ m_wheels.size() };
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ m_wheels.size() }; ++typeId)
+                solution.setAttributeAssignment(typeId, assignment(typeId));
+            return solution;
+        }
+
+    private:
+        const AttributeAssignment& assignment(AttributeTypeID typeId) const
+        {
+            return (*m_wheels[typeId])[m_rows[typeId]];
+        }
+
+    private:
+        utils::IndexedVector<AttributeTypeID, const Wheel*> m_wheels;
+        utils::IndexedVector<AttributeTypeID, RowIndex> m_rows;
+    };
+
+    // -------------------------------- join planning ------------------------------------------------
+
+    // Fraction of tuples (of the involved wheels) satisfying the constraint: exact for small products, else sampled.
+    double estimateSelectivity(const bruteforce::ConstraintChecker& checker, const std::vector<AttributeTypeID>& types,
+        const utils::IndexedVector<AttributeTypeID, std::vector<RowIndex>>& rows, TupleView& view)
+    {
+        constexpr std::uint64_t maxSamples = 4096;
+        std::uint64_t product = 1;
+        for (const auto typeId : types)
+            product = (product > maxSamples) ? product : product * rows[typeId].size();
+
+        std::uint64_t satisfied = 0;
+        std::uint64_t samples = 0;
+        if (product <= maxSamples)
+        {
+            for (; samples < product; ++samples)
+            {
+                auto index = samples; // mixed radix number: digit per type
+                for (const auto typeId : types)
+                {
+                    view.setRow(typeId, rows[typeId][index % rows[typeId].size()]);
+                    index /= rows[typeId].size();
+                }
+                satisfied += checker.satisfiedBy(view);
+            }
+        }
+        else
+        {
+            std::mt19937_64 rng; // fixed seed: the same plan for the same puzzle
+            for (; samples < maxSamples; ++samples)
+            {
+                for (const auto typeId : types)
+                    view.setRow(typeId, rows[typeId][std::uniform_int_distribution<size_t>(0, rows[typeId].size() - 1)(rng)]);
+                satisfied += checker.satisfiedBy(view);
+            }
+        }
+        // A never satisfied sample does not prove emptiness: keep the estimate positive
+        return std::max(static_cast<double>(satisfied), 0.5) / static_cast<double>(samples);
+    }
+
+    // Greedy cost-based join order: the next wheel gives the smallest estimated intermediate result.
+    std::vector<JoinStep> makePlan(const PuzzleModel& model, const std::vector<std::unique_ptr<bruteforce::ConstraintChecker>>& checkers,
+        const utils::IndexedVector<AttributeTypeID, std::vector<RowIndex>>& rows, TupleView& view)
+    {
+        const auto& constraints = model.constraints();
+        std::vector<std::vector<AttributeTypeID>> constraintTypes;
+        std::vector<double> selectivity;
+        for (size_t constrIndex = 0; constrIndex < constraints.size(); ++constrIndex)
+        {
+            constraintTypes.push_back(involvedAttrTypes(constraints[constrIndex]));
+            selectivity.push_back(constraintTypes.back().size() > 1
+                ? estimateSelectivity(*checkers[constrIndex], constraintTypes.back(), rows, view) : 1.0);
+        }
+
+        std::vector<JoinStep> plan;
+        std::vector<bool> bound(model.attrTypeCount(), false);
+        double estimatedRows = 1;
+        while (plan.size() < model.attrTypeCount())
+        {
+            std::optional<JoinStep> best;
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ model.attrTypeCount() }; ++typeId)
+            {
+                if (bound[typeId.value()])
+                    continue;
+
+                JoinStep step{ .typeId = typeId, .hashKey = {}, .filters = {}, .estimatedRows = estimatedRows * static_cast<double>(rows[typeId].size()) };
+                for (size_t constrIndex = 0; constrIndex < constraints.size(); ++constrIndex)
+                {
+                    const auto& types = constraintTypes[constrIndex];
+                    const bool completed = types.size() > 1 && std::ranges::find(types, typeId) != types.end()
+                        && std::ranges::all_of(types, [&bound, typeId](AttributeTypeID other) { return other == typeId || bound[other.value()]; });
+                    if (!completed)
+                        continue;
+
+                    step.estimatedRows *= selectivity[constrIndex];
+                    const auto* sameOwner = std::get_if<SameOwner>(&constraints[constrIndex]);
+                    if (!step.hashKey && sameOwner && !sameOwner->secondNegate)
+                    {
+                        // normalize: the key value of the joined wheel is the second one
+                        step.hashKey = (sameOwner->second.typeId == typeId) ? *sameOwner : SameOwner{ sameOwner->second, sameOwner->first };
+                        continue;
+                    }
+                    step.filters.push_back(constrIndex);
+                }
+
+                if (!best || step.estimatedRows < best->estimatedRows)
+                    best = std::move(step);
+            }
+
+            bound[best->typeId.value()] = true;
+            estimatedRows = best->estimatedRows;
+            plan.push_back(std::move(*best));
+        }
+        return plan;
+    }
+
+    // -------------------------------- class StepProgress ------------------------------------------------
+
+    // Overall progress: each join step takes an equal share, inside the step - share of the processed input rows.
+    class StepProgress
+    {
+    public:
+        StepProgress(const Solver::SolveOptions& opts, size_t stepCount)
+            : m_opts(opts)
+            , m_total(stepShare * std::max<size_t>(stepCount, 1))
+            , m_lastTime(std::chrono::steady_clock::now())
+        {
+        }
+
+        // Return false if user canceled
+        bool update(size_t stepIndex, std::uint64_t processed, std::uint64_t inputRows)
+        {
+            constexpr std::uint64_t clockCheckInterval = 1024;
+            if (++m_calls % clockCheckInterval != 0 || std::chrono::steady_clock::now() - m_lastTime < m_opts.progressInterval)
+                return true;
+
+            m_lastTime = std::chrono::steady_clock::now();
+            const auto stepDone = static_cast<double>(processed) / static_cast<double>(std::max<std::uint64_t>(inputRows, 1));
+            return m_opts.progressCallback(m_total, stepShare * stepIndex + static_cast<std::uint64_t>(stepDone * stepShare));
+        }
+
+        void start()
+        {
+            m_opts.progressCallback(m_total, 0);
+        }
+
+        void finish()
+        {
+            m_opts.progressCallback(m_total, m_total);
+        }
+
+    private:
+        static constexpr std::uint64_t stepShare = 1'000'000;
+        const Solver::SolveOptions& m_opts;
+        const std::uint64_t m_total;
+        std::chrono::steady_clock::time_point m_lastTime;
+        std::uint64_t m_calls = 0;
+    };
+
+} // namespace
+
+    JoinSolver::JoinSolver(bruteforce::SolverContext&& ctx)
+        : m_ctx(std::move(ctx))
+        , m_rows(m_ctx.puzzleModel().attrTypeCount())
+    {
+        const auto& model = m_ctx.puzzleModel();
+        for (const auto& constraint : model.constraints())
+            m_checkers.push_back(bruteforce::ConstraintChecker::create(constraint));
+
+        // Selection: single-type constraints filter the wheels (nothing to filter, if the prefilter has already applied them)
+        TupleView view{ m_ctx.searchSpace(), model.attrTypeCount() };
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ model.attrTypeCount() }; ++typeId)
+        {
+            std::vector<const bruteforce::ConstraintChecker*> selection;
+            for (size_t constrIndex = 0; constrIndex < m_checkers.size(); ++constrIndex)
+            {
+                if (involvedAttrTypes(model.constraints()[constrIndex]) == std::vector{ typeId })
+                    selection.push_back(m_checkers[constrIndex].get());
+            }
+
+            const auto wheelSize = m_ctx.searchSpace().wheelSize(typeId);
+            ENSURE(wheelSize <= std::numeric_limits<RowIndex>::max(), "Too large wheel for the join: " << wheelSize);
+            for (RowIndex row = 0; row < wheelSize; ++row)
+            {
+                view.setRow(typeId, row);
+                if (std::ranges::all_of(selection, [&view](const auto* checker) { return checker->satisfiedBy(view); }))
+                    m_rows[typeId].push_back(row);
+            }
+        }
+
+        const bool empty = std::ranges::any_of(m_rows, [](const auto& rows) { return rows.empty(); });
+        if (!empty)
+            m_plan = makePlan(model, m_checkers, m_rows, view);
+    }
+
+    std::vector<PuzzleSolution> JoinSolver::solve(const SolveOptions& opts)
+    {
+        return solveSet(opts).toVector();
+    }
+
+    SolutionSet JoinSolver::solveSet(const SolveOptions& opts)
+    {
+        return m_ctx.makeSolutionSet(search(opts));
+    }
+
+    std::vector<PuzzleSolution> JoinSolver::search(const SolveOptions& opts) const
+    {
+        StepProgress progress{ opts, m_plan.size() };
+        progress.start();
+
+        const auto& model = m_ctx.puzzleModel();
+        TupleView view{ m_ctx.searchSpace(), model.attrTypeCount() };
+
+        // Columnar intermediate result: a column of wheel rows per bound type (in plan order). Initially - one empty tuple.
+        std::vector<std::vector<RowIndex>> columns;
+        std::uint64_t rowCount = m_plan.empty() ? 0 : 1;
+        for (size_t stepIndex = 0; stepIndex < m_plan.size() && rowCount > 0; ++stepIndex)
+        {
+            const auto& step = m_plan[stepIndex];
+            const auto& stepRows = m_rows[step.typeId];
+
+            // Hash join index: joined wheel rows by the owner of the key value. Persons are dense, so a bucket per person.
+            std::vector<std::vector<RowIndex>> buckets;
+            if (step.hashKey)
+            {
+                buckets.resize(model.personCount());
+                for (const auto row : stepRows)
+                {
+                    view.setRow(step.typeId, row);
+                    buckets[view.ownerOf(step.hashKey->second.typeId, step.hashKey->second.valueId).value()].push_back(row);
+                }
+            }
+
+            std::vector<std::vector<RowIndex>> joined(columns.size() + 1);
+            for (std::uint64_t rowIndex = 0; rowIndex < rowCount; ++rowIndex)
+            {
+                for (size_t column = 0; column < columns.size(); ++column)
+                    view.setRow(m_plan[column].typeId, columns[column][rowIndex]);
+
+                const auto& candidates = step.hashKey
+                    ? buckets[view.ownerOf(step.hashKey->first.typeId, step.hashKey->first.valueId).value()] : stepRows;
+                for (const auto row : candidates)
+                {
+                    view.setRow(step.typeId, row);
+                    if (!std::ranges::all_of(step.filters, [this, &view](size_t constrIndex) { return m_checkers[constrIndex]->satisfiedBy(view); }))
+                        continue;
+
+                    for (size_t column = 0; column < columns.size(); ++column)
+                        joined[column].push_back(columns[column][rowIndex]);
+                    joined.back().push_back(row);
+                }
+
+                if (!progress.update(stepIndex, rowIndex, rowCount)) [[unlikely]] // user canceled
+                    return {};
+            }
+            columns = std::move(joined);
+            rowCount = columns.back().size();
+        }
+
+        std::vector<PuzzleSolution> solutions;
+        solutions.reserve(rowCount);
+        for (std::uint64_t rowIndex = 0; rowIndex < rowCount; ++rowIndex)
+        {
+            for (size_t column = 0; column < columns.size(); ++column)
+                view.setRow(m_plan[column].typeId, columns[column][rowIndex]);
+            solutions.push_back(view.getSolutionModel().toPuzzleSolution(model));
+        }
+        progress.finish();
+        return solutions;
+    }
+
+    Solver::Statistics JoinSolver::statistics() const
+    {
+        auto stats = m_ctx.statistics();
+        const auto& model = m_ctx.puzzleModel();
+        for (size_t stepIndex = 0; stepIndex < m_plan.size(); ++stepIndex)
+        {
+            const auto& step = m_plan[stepIndex];
+            std::ostringstream value;
+            value << m_rows[step.typeId].size() << " rows, " << (step.hashKey ? "hash join" : "nested loop")
+                << ", " << step.filters.size() << " filters, estimated result " << step.estimatedRows << " rows";
+            stats.emplace_back("Join " + std::to_string(stepIndex + 1) + " '" + std::string(model.attrTypeName(step.typeId)) + "'", value.str());
+        }
+        if (m_plan.empty())
+            stats.emplace_back("Join", "empty relation, no solutions");
+        return stats;
+    }
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "epuzzle/Solver.h"
+#include "bruteforce/SolverContext.h"
+
+namespace epuzzle::details::join
+{
+    // One step of the join plan: the next wheel joined to the intermediate result.
+    struct JoinStep
+    {
+        AttributeTypeID typeId;
+        // Equi-join predicate (hash join): owners of first (bound type) and second (typeId) values are equal. Else nested loop.
+        std::optional<SameOwner> hashKey;
+        std::vector<size_t> filters; // constraints (indexes) completed by this step, checked on each joined row
+        double estimatedRows = 0;
+    };
+
+    // Relational join engine over the bruteforce wheels (see SearchSpace): each wheel is a relation of allowed permutations,
+    // constraints involving several attribute types are join predicates. The wheels are joined one by one in a cost-based
+    // (greedy, by estimated intermediate result size) order; each predicate is applied as soon as all its types are joined.
+    // Intermediate results are columnar buffers of wheel row indexes, so they stay tiny when the Cartesian product is huge.
+    class JoinSolver final : public Solver
+    {
+    public:
+        explicit JoinSolver(bruteforce::SolverContext&&);
+
+        std::vector<PuzzleSolution> solve(const SolveOptions&) override;
+        SolutionSet solveSet(const SolveOptions&) override;
+        Statistics statistics() const override;
+
+    private:
+        std::vector<PuzzleSolution> search(const SolveOptions&) const;
+
+    private:
+        const bruteforce::SolverContext m_ctx;
+        std::vector<std::unique_ptr<bruteforce::ConstraintChecker>> m_checkers; // index: constraint
+        utils::IndexedVector<AttributeTypeID, std::vector<std::uint32_t>> m_rows; // wheel rows passing single-type constraints
+        std::vector<JoinStep> m_plan;
+    };
+
+}
@@ -0,0 +1,289 @@
+#include "bruteforce/ConstraintChecker.h"
+#include "LocalSearchSolver.h"
+
+namespace epuzzle::details::localsearch
+{
+namespace
+{
+    // -------------------------------- class AssignmentState ------------------------------------------------
+
+    // Full assignment: a permutation of persons for each attribute type, plus inverse permutations for O(1) position lookups.
+    // It is exposed as a (single candidate) cursor, so constraints are evaluated by the same checkers as in bruteforce.
+    class AssignmentState final : public bruteforce::SearchSpaceCursor
+    {
+    public:
+        AssignmentState(size_t personCount, size_t attrTypeCount, std::mt19937_64& rng)
+            : m_owners(attrTypeCount)
+            , m_positions(attrTypeCount)
+        {
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ attrTypeCount }; ++typeId)
+            {
+                auto& owners = m_owners[typeId];
+                owners = AttributeAssignment(personCount);
+                std::iota(owners.begin(), owners.end(), PersonID{ 0 });
+                std::ranges::shuffle(owners, rng);
+
+                m_positions[typeId] = utils::IndexedVector<PersonID, AttributeValueID>(personCount);
+                for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ personCount }; ++valueId)
+                    m_positions[typeId][owners[valueId]] = valueId;
+            }
+        }
+
+        void swapOwners(AttributeTypeID typeId, AttributeValueID first, AttributeValueID second)
+        {
+            auto& owners = m_owners[typeId];
+            std::swap(owners[first], owners[second]);
+            m_positions[typeId][owners[first]] = first;
+            m_positions[typeId][owners[second]] = second;
+        }
+
+        bool moveNext() override
+        {
+            return false; // the state is changed by swapOwners() only
+        }
+
+        PersonID ownerOf(AttributeTypeID typeId, AttributeValueID valueId) const override
+        {
+            return m_owners[typeId][valueId];
+        }
+
+        size_t personPosition(PersonID personId, AttributeTypeID typeId) const override
+        {
+            return m_positions[typeId][personId].value();
+        }
+
+        SolutionModel getSolutionModel() const override
+        {
+            SolutionModel solution{ m_owners.size() };
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ m_owners.size() }; ++typeId)
+                solution.setAttributeAssignment(typeId, m_owners[typeId]);
+            return solution;
+        }
+
+    private:
+        utils::IndexedVector<AttributeTypeID, AttributeAssignment> m_owners;
+        utils::IndexedVector<AttributeTypeID, utils::IndexedVector<PersonID, AttributeValueID>> m_positions;
+    };
+
+    // -------------------------------- class MinConflictsSearch ------------------------------------------------
+
+    struct Move
+    {
+        AttributeTypeID typeId;
+        AttributeValueID first;
+        AttributeValueID second;
+    };
+
+    class MinConflictsSearch
+    {
+    public:
+        MinConflictsSearch(const SolverConfig::LocalSearchConfig& config, const PuzzleModel& model)
+            : m_config(config)
+            , m_personCount(model.personCount())
+            , m_rng(config.seed)
+            , m_state(model.personCount(), model.attrTypeCount(), m_rng)
+            , m_constraintsByType(model.attrTypeCount())
+            , m_tabuUntil(model.attrTypeCount())
+        {
+            const auto& constraints = model.constraints();
+            m_checkers.reserve(constraints.size());
+            m_constraintTypes.reserve(constraints.size());
+            for (size_t constrIndex = 0; constrIndex < constraints.size(); ++constrIndex)
+            {
+                m_checkers.push_back(bruteforce::ConstraintChecker::create(constraints[constrIndex]));
+                m_constraintTypes.push_back(involvedAttrTypes(constraints[constrIndex]));
+                for (const auto typeId : m_constraintTypes.back())
+                    m_constraintsByType[typeId].push_back(constrIndex);
+            }
+
+            for (auto& tabu : m_tabuUntil)
+                tabu.resize(m_personCount, 0);
+
+            m_violated.resize(m_checkers.size());
+            for (size_t constrIndex = 0; constrIndex < m_checkers.size(); ++constrIndex)
+            {
+                m_violated[constrIndex] = !m_checkers[constrIndex]->satisfiedBy(m_state);
+                m_violatedCount += m_violated[constrIndex];
+            }
+            m_bestViolatedCount = m_violatedCount;
+        }
+
+        bool solved() const
+        {
+            return m_violatedCount == 0;
+        }
+
+        const AssignmentState& state() const
+        {
+            return m_state;
+        }
+
+        void step()
+        {
+            ++m_iteration;
+
+            // Min-conflicts: focus on moves that can repair a random violated constraint
+            const auto candidates = candidateMoves(randomViolatedConstraint());
+
+            const Move* chosen = nullptr;
+            if (std::bernoulli_distribution(m_config.randomWalkProbability)(m_rng))
+            {
+                chosen = &candidates[randomIndex(candidates.size())];
+            }
+            else
+            {
+                // Best non-tabu move (ties broken randomly); a tabu move is allowed if it gives a new best score (aspiration)
+                int bestDelta = std::numeric_limits<int>::max();
+                size_t tiesCount = 0;
+                for (const auto& move : candidates)
+                {
+                    const int delta = evaluateDelta(move);
+                    const bool aspiration = static_cast<std::int64_t>(m_violatedCount) + delta < static_cast<std::int64_t>(m_bestViolatedCount);
+                    if (isTabu(move) && !aspiration)
+                        continue;
+
+                    if (delta < bestDelta)
+                    {
+                        bestDelta = delta;
+                        chosen = &move;
+                        tiesCount = 1;
+                    }
+                    else if (delta == bestDelta && randomIndex(++tiesCount) == 0)
+                    {
+                        chosen = &move;
+                    }
+                }
+                if (!chosen) // everything is tabu
+                    chosen = &candidates[randomIndex(candidates.size())];
+            }
+
+            apply(*chosen);
+            m_bestViolatedCount = std::min(m_bestViolatedCount, m_violatedCount);
+        }
+
+    private:
+        size_t randomIndex(size_t count)
+        {
+            return std::uniform_int_distribution<size_t>(0, count - 1)(m_rng);
+        }
+
+        size_t randomViolatedConstraint()
+        {
+            size_t target = randomIndex(m_violatedCount);
+            for (size_t constrIndex = 0; constrIndex < m_violated.size(); ++constrIndex)
+            {
+                if (m_violated[constrIndex] && target-- == 0)
+                    return constrIndex;
+            }
+            ENSURE(false, "Violated constraints count is out of sync!");
+        }
+
+        std::vector<Move> candidateMoves(size_t constrIndex) const
+        {
+            std::vector<Move> moves;
+            moves.reserve(m_constraintTypes[constrIndex].size() * m_personCount * (m_personCount - 1) / 2);
+            for (const auto typeId : m_constraintTypes[constrIndex])
+            {
+                for (auto first = AttributeValueID{ 0 }; first < AttributeValueID{ m_personCount }; ++first)
+                {
+                    for (auto second = AttributeValueID{ first.value() + 1 }; second < AttributeValueID{ m_personCount }; ++second)
+                        moves.push_back({ .typeId = typeId, .first = first, .second = second });
+                }
+            }
+            return moves;
+        }
+
+        bool isTabu(const Move& move) const
+        {
+            const auto& tabu = m_tabuUntil[move.typeId];
+            return tabu[move.first.value()] > m_iteration || tabu[move.second.value()] > m_iteration;
+        }
+
+        // Change of the violated constraints count, if the move would be applied. Only constraints depending on the moved type are re-checked.
+        int evaluateDelta(const Move& move)
+        {
+            m_state.swapOwners(move.typeId, move.first, move.second);
+            int delta = 0;
+            for (const auto constrIndex : m_constraintsByType[move.typeId])
+                delta += static_cast<int>(!m_checkers[constrIndex]->satisfiedBy(m_state)) - static_cast<int>(m_violated[constrIndex]);
+            m_state.swapOwners(move.typeId, move.first, move.second); // revert
+            return delta;
+        }
+
+        void apply(const Move& move)
+        {
+            m_state.swapOwners(move.typeId, move.first, move.second);
+            for (const auto constrIndex : m_constraintsByType[move.typeId])
+            {
+                const bool violated = !m_checkers[constrIndex]->satisfiedBy(m_state);
+                m_violatedCount = m_violatedCount - m_violated[constrIndex] + violated;
+                m_violated[constrIndex] = violated;
+            }
+            auto& tabu = m_tabuUntil[move.typeId];
+            tabu[move.first.value()] = tabu[move.second.value()] = m_iteration + m_config.tabuTenure;
+        }
+
+    private:
+        const SolverConfig::LocalSearchConfig& m_config;
+        const size_t m_personCount;
+        std::mt19937_64 m_rng;
+        AssignmentState m_state;
+
+        std::vector<std::unique_ptr<bruteforce::ConstraintChecker>> m_checkers;
+        std::vector<std::vector<AttributeTypeID>> m_constraintTypes; // index: constraint
+        utils::IndexedVector<AttributeTypeID, std::vector<size_t>> m_constraintsByType;
+
+        std::vector<std::uint8_t> m_violated; // index: constraint
+        size_t m_violatedCount = 0;
+        size_t m_bestViolatedCount = 0;
+
+        utils::IndexedVector<AttributeTypeID, std::vector<std::uint64_t>> m_tabuUntil; // index: value -> iteration
+        std::uint64_t m_iteration = 0;
+    };
+
+} // namespace
+
+    LocalSearchSolver::LocalSearchSolver(const SolverConfig::LocalSearchConfig& config, PuzzleModel&& puzzleModel)
+        : m_config(config)
+        , m_puzzleModel(std::move(puzzleModel))
+    {
+    }
+
+    std::vector<PuzzleSolution> LocalSearchSolver::solve(const SolveOptions& opts)
+    {
+        using namespace std::chrono;
+        // Progress is measured in milliseconds of the time budget
+        const auto total = static_cast<std::uint64_t>(m_config.timeBudget.count());
+        if (!opts.progressCallback(total, 0))
+            return {};
+
+        const utils::Stopwatch sw;
+        auto lastProgressTime = steady_clock::now();
+        constexpr std::uint64_t clockCheckInterval = 64;
+
+        MinConflictsSearch search{ m_config, m_puzzleModel };
+        for (std::uint64_t iteration = 0; !search.solved(); ++iteration)
+        {
+            if (iteration % clockCheckInterval == 0) [[unlikely]]
+            {
+                const auto elapsed = duration_cast<milliseconds>(sw.elapsed());
+                if (elapsed >= m_config.timeBudget)
+                {
+                    opts.progressCallback(total, total);
+                    return {};
+                }
+                if (steady_clock::now() - lastProgressTime >= opts.progressInterval)
+                {
+                    lastProgressTime = steady_clock::now();
+                    if (!opts.progressCallback(total, static_cast<std::uint64_t>(elapsed.count()))) // user canceled
+                        return {};
+                }
+            }
+            search.step();
+        }
+
+        opts.progressCallback(total, total);
+        return { search.state().getSolutionModel().toPuzzleSolution(m_puzzleModel) };
+    }
+
+}
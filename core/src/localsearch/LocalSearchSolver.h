@@ -0,0 +1,23 @@
+#pragma once
+#include "epuzzle/Solver.h"
+#include "PuzzleModel.h"
+
+namespace epuzzle::details::localsearch
+{
+    // Stochastic min-conflicts local search over full assignments (one permutation of persons per attribute type).
+    // Move: swap the owners of two values of one attribute. Score: count of violated constraints, maintained incrementally.
+    // Local minima and plateaus are escaped by tabu moves and random walk.
+    // Incomplete method: returns at most one solution and may return none within the time budget even if the puzzle is solvable.
+    class LocalSearchSolver final : public Solver
+    {
+    public:
+        LocalSearchSolver(const SolverConfig::LocalSearchConfig&, PuzzleModel&&);
+
+        std::vector<PuzzleSolution> solve(const SolveOptions&) override;
+
+    private:
+        const SolverConfig::LocalSearchConfig m_config;
+        const PuzzleModel m_puzzleModel;
+    };
+
+}
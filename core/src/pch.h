@@ -1,8 +1,20 @@
 #pragma once
 
+#include <array>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <limits>
+#include <list>
+#include <map>
 #include <memory>
+#include <memory_resource>
 #include <numeric>
+#include <random>
+#include <set>
+#include <span>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "utils/Concurrency.h"
@@ -10,4 +22,5 @@
 #include "utils/Math.h"
 #include "utils/Meta.h"
 #include "utils/Progress.h"
-#include "utils/Text.h"
\ No newline at end of file
+#include "utils/Text.h"
+#include "utils/platform/LargePages.h"
\ No newline at end of file
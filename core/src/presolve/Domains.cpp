@@ -0,0 +1,83 @@
+#include "Domains.h"
+
+namespace epuzzle::details::presolve
+{
+
+    Domains::Domains(size_t personCount, size_t attrTypeCount)
+        : m_personCount(personCount)
+        , m_owners(attrTypeCount)
+    {
+        ENSURE(0 < personCount && personCount <= maxPersonCount, "Unsupported person count for presolve: " << personCount);
+        const PersonSet everybody = (personCount == maxPersonCount) ? ~PersonSet{ 0 } : (PersonSet{ 1 } << personCount) - 1;
+        for (auto& values : m_owners)
+            values = utils::IndexedVector<AttributeValueID, PersonSet>(std::vector<PersonSet>(personCount, everybody));
+    }
+
+    size_t Domains::personCount() const
+    {
+        return m_personCount;
+    }
+
+    size_t Domains::attrTypeCount() const
+    {
+        return m_owners.size();
+    }
+
+    PersonSet Domains::owners(AttributeTypeID typeId, AttributeValueID valueId) const
+    {
+        return m_owners[typeId][valueId];
+    }
+
+    bool Domains::allows(AttributeTypeID typeId, AttributeValueID valueId, PersonID personId) const
+    {
+        return (owners(typeId, valueId) & single(personId)) != 0;
+    }
+
+    bool Domains::allows(AttributeTypeID typeId, const AttributeAssignment& assignment) const
+    {
+        for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ assignment.size() }; ++valueId)
+        {
+            if (!allows(typeId, valueId, assignment[valueId]))
+                return false;
+        }
+        return true;
+    }
+
+    bool Domains::restrict(AttributeTypeID typeId, AttributeValueID valueId, PersonSet persons)
+    {
+        auto& domain = m_owners[typeId][valueId];
+        const auto restricted = domain & persons;
+        const bool changed = restricted != domain;
+        domain = restricted;
+        return changed;
+    }
+
+    bool Domains::remove(AttributeTypeID typeId, AttributeValueID valueId, PersonID personId)
+    {
+        return restrict(typeId, valueId, ~single(personId));
+    }
+
+    bool Domains::isFixed(AttributeTypeID typeId, AttributeValueID valueId) const
+    {
+        return std::has_single_bit(owners(typeId, valueId));
+    }
+
+    bool Domains::isFixed(AttributeTypeID typeId) const
+    {
+        return fixedCount(typeId) == m_personCount;
+    }
+
+    size_t Domains::fixedCount(AttributeTypeID typeId) const
+    {
+        return static_cast<size_t>(std::ranges::count_if(m_owners[typeId], [](PersonSet domain) { return std::has_single_bit(domain); }));
+    }
+
+    size_t Domains::allowedCount(AttributeTypeID typeId) const
+    {
+        size_t count = 0;
+        for (const auto domain : m_owners[typeId])
+            count += static_cast<size_t>(std::popcount(domain));
+        return count;
+    }
+
+}
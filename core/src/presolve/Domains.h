@@ -0,0 +1,51 @@
+#pragma once
+#include "IndexedTypes.h"
+
+namespace epuzzle::details::presolve
+{
+    // Set of persons as a bit mask (bit N - PersonID{N})
+    using PersonSet = std::uint64_t;
+
+    // Call fn(index) for each set bit of the mask (PersonSet and similar), in ascending order
+    template <typename TFunc>
+    void forEachBit(std::uint64_t mask, TFunc fn)
+    {
+        for (; mask != 0; mask &= mask - 1)
+            fn(static_cast<size_t>(std::countr_zero(mask)));
+    }
+
+    // Possible owners of each value of each attribute type (person x value domains).
+    // Initially every person may own every value; presolve stages narrow the domains down.
+    // Value semantic: cheap to copy for tentative propagation.
+    class Domains
+    {
+    public:
+        static constexpr size_t maxPersonCount = 64; // PersonSet bits
+
+        Domains(size_t personCount, size_t attrTypeCount);
+
+        size_t personCount() const;
+        size_t attrTypeCount() const;
+
+        PersonSet owners(AttributeTypeID, AttributeValueID) const;
+        bool allows(AttributeTypeID, AttributeValueID, PersonID) const;
+        // True if every value of the assignment belongs to a person from its domain. Compatible with SearchSpace::AllowFilter.
+        bool allows(AttributeTypeID, const AttributeAssignment&) const;
+
+        // Intersect domain with the set. Return true if domain changed.
+        bool restrict(AttributeTypeID, AttributeValueID, PersonSet);
+        bool remove(AttributeTypeID, AttributeValueID, PersonID);
+
+        bool isFixed(AttributeTypeID, AttributeValueID) const; // exactly one possible owner
+        bool isFixed(AttributeTypeID) const; // all values fixed
+        size_t fixedCount(AttributeTypeID) const;
+        size_t allowedCount(AttributeTypeID) const; // count of allowed (person, value) cells
+
+        static PersonSet single(PersonID person) { return PersonSet{ 1 } << person.value(); }
+
+    private:
+        size_t m_personCount = 0;
+        utils::IndexedVector<AttributeTypeID, utils::IndexedVector<AttributeValueID, PersonSet>> m_owners;
+    };
+
+}
@@ -0,0 +1,106 @@
+#include "Prober.h"
+
+namespace epuzzle::details::presolve
+{
+
+    Prober::Prober(const Propagator& propagator, size_t threadCount)
+        : m_propagator(propagator)
+        , m_threadCount(std::max<size_t>(1, threadCount))
+    {
+    }
+
+    bool Prober::probe(Domains& domains) const
+    {
+        if (!m_propagator.propagate(domains))
+            return false;
+
+        // All literals failed in one round are pruned together: each of them fails on the round's (wider) domains, so on narrower ones too
+        for (auto failed = failedLiterals(domains); !failed.empty(); failed = failedLiterals(domains))
+        {
+            for (const auto& literal : failed)
+                domains.remove(literal.typeId, literal.valueId, literal.personId);
+
+            if (!m_propagator.propagate(domains))
+                return false;
+        }
+        return true;
+    }
+
+    std::vector<Prober::Literal> Prober::failedLiterals(const Domains& domains) const
+    {
+        std::vector<Literal> candidates;
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ domains.attrTypeCount() }; ++typeId)
+        {
+            for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ domains.personCount() }; ++valueId)
+            {
+                if (domains.isFixed(typeId, valueId))
+                    continue;
+                forEachBit(domains.owners(typeId, valueId), [&candidates, typeId, valueId](size_t person)
+                    {
+                        candidates.push_back({ .typeId = typeId, .valueId = valueId, .personId = PersonID{ person } });
+                    });
+            }
+        }
+        if (candidates.empty())
+            return {};
+
+        std::atomic<size_t> nextCandidate = 0;
+        utils::ParallelExecutor<std::vector<Literal>> executor{ std::min(m_threadCount, candidates.size()),
+            [this, &domains, &candidates, &nextCandidate](std::stop_token st)
+            {
+                std::vector<Literal> threadResult;
+                for (size_t index = nextCandidate++; index < candidates.size() && !st.stop_requested(); index = nextCandidate++)
+                {
+                    const auto& literal = candidates[index];
+                    auto probed = domains; // tentative assignment on a copy
+                    probed.restrict(literal.typeId, literal.valueId, Domains::single(literal.personId));
+                    if (!m_propagator.propagate(probed))
+                        threadResult.push_back(literal);
+                }
+                return threadResult;
+            } };
+
+        return utils::join(executor.collectResults());
+    }
+
+    void addProbedFacts(PuzzleModel& model, size_t threadCount)
+    {
+        if (model.personCount() > Domains::maxPersonCount)
+            return;
+
+        const Propagator propagator{ model };
+        const auto initial = propagator.initialDomains(); // the model facts already
+        auto domains = initial;
+        const Prober prober{ propagator, threadCount };
+        const bool consistent = prober.probe(domains);
+
+        // Only the cells pruned beyond the model facts; a fixed value - one fact instead of its negations
+        std::vector<ConstraintModel> facts;
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ model.attrTypeCount() }; ++typeId)
+        {
+            for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ model.personCount() }; ++valueId)
+            {
+                const Attribute attr{ .typeId = typeId, .valueId = valueId };
+                const auto before = initial.owners(typeId, valueId);
+                const auto owners = consistent ? domains.owners(typeId, valueId) : PersonSet{ 0 };
+                if (owners == before)
+                    continue;
+                if (std::has_single_bit(owners))
+                {
+                    facts.emplace_back(std::in_place_type<PersonProperty>, PersonID{ static_cast<size_t>(std::countr_zero(owners)) }, attr, false);
+                    continue;
+                }
+                forEachBit(before & ~owners, [&facts, attr](size_t person)
+                    {
+                        facts.emplace_back(std::in_place_type<PersonProperty>, PersonID{ person }, attr, true);
+                    });
+                if (!consistent)
+                    break; // one value without owners is the contradiction
+            }
+            if (!consistent && !facts.empty())
+                break;
+        }
+        model.addConstraints(std::move(facts));
+    }
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "Propagator.h"
+
+namespace epuzzle::details::presolve
+{
+    // Failed-literal probing (singleton arc consistency): each undecided (person, value) pair is tentatively assigned
+    // and propagated; if it leads to a contradiction, the pair is impossible and is pruned permanently.
+    // Rounds repeat until no more literals fail. Probes of one round are independent and run in parallel.
+    class Prober
+    {
+    public:
+        Prober(const Propagator&, size_t threadCount);
+
+        // Return false if a contradiction is found (the domains admit no solution).
+        bool probe(Domains&) const;
+
+    private:
+        struct Literal
+        {
+            AttributeTypeID typeId;
+            AttributeValueID valueId;
+            PersonID personId;
+        };
+        std::vector<Literal> failedLiterals(const Domains&) const;
+
+    private:
+        const Propagator& m_propagator;
+        const size_t m_threadCount;
+    };
+
+    // Probe the model domains and append the cells pruned beyond the model facts as PersonProperty facts, so every solving method
+    // benefits. A model without solutions gets contradicting facts.
+    void addProbedFacts(PuzzleModel&, size_t threadCount);
+
+}
@@ -0,0 +1,254 @@
+#include "Propagator.h"
+
+namespace epuzzle::details::presolve
+{
+namespace
+{
+    using Relation = PuzzleDefinition::Comparison::Relation;
+
+    // Bit N - AttributeValueID{N} of the compareBy attribute type (i.e. N-th position)
+    using PositionSet = std::uint64_t;
+    using PositionsByPerson = std::array<PositionSet, Domains::maxPersonCount>; // on stack: revise() is called in hot loops
+
+    constexpr PositionSet positionBit(size_t pos)
+    {
+        return pos < 64 ? PositionSet{ 1 } << pos : 0;
+    }
+
+    // Positions of the second comparable satisfying the relation, when the first one is at `pos`
+    PositionSet partnerPositions(Relation relation, size_t pos, PositionSet allPositions)
+    {
+        const PositionSet lower = positionBit(pos) - 1;
+        const PositionSet left = pos > 0 ? positionBit(pos - 1) : 0;
+        const PositionSet right = positionBit(pos + 1) & allPositions;
+        switch (relation)
+        {
+        case Relation::ImmediateLeft:   return right;
+        case Relation::ImmediateRight:  return left;
+        case Relation::Adjacent:        return left | right;
+        case Relation::Before:          return allPositions & ~lower & ~positionBit(pos);
+        case Relation::After:           return lower;
+        default: ENSURE(false, "Unexpected PositionComparison::relation: (int)" << static_cast<int>(relation));
+        };
+    }
+
+    // The same relation from the point of view of the second comparable
+    Relation reversed(Relation relation)
+    {
+        switch (relation)
+        {
+        case Relation::ImmediateLeft:   return Relation::ImmediateRight;
+        case Relation::ImmediateRight:  return Relation::ImmediateLeft;
+        case Relation::Before:          return Relation::After;
+        case Relation::After:           return Relation::Before;
+        default:                        return relation;
+        };
+    }
+
+    bool isConsistent(AttributeTypeID typeId, const Domains& domains)
+    {
+        PersonSet covered = 0;
+        for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ domains.personCount() }; ++valueId)
+        {
+            const auto owners = domains.owners(typeId, valueId);
+            if (owners == 0)
+                return false;
+            covered |= owners;
+        }
+        return std::popcount(covered) == static_cast<int>(domains.personCount()); // every person must own some value
+    }
+
+} // namespace
+
+    Propagator::Propagator(const PuzzleModel& model)
+        : m_model(model)
+    {
+        for (const auto& constraint : model.constraints())
+        {
+            std::visit(utils::overloaded
+                {
+                    [this](const PersonProperty& property) { m_unaryFacts.push_back(property); },
+                    [this](const SameOwner& sameOwner) { m_sameOwners.push_back(sameOwner); },
+                    [this](const PositionComparison& comparison) { m_comparisons.push_back(comparison); },
+                }, constraint);
+        }
+    }
+
+    Domains Propagator::initialDomains() const
+    {
+        Domains domains{ m_model.personCount(), m_model.attrTypeCount() };
+        for (const auto& fact : m_unaryFacts)
+        {
+            const auto person = Domains::single(fact.person);
+            domains.restrict(fact.attr.typeId, fact.attr.valueId, fact.negate ? ~person : person);
+        }
+        return domains;
+    }
+
+    bool Propagator::propagate(Domains& domains) const
+    {
+        const auto attrTypeCount = AttributeTypeID{ domains.attrTypeCount() };
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            for (const auto& sameOwner : m_sameOwners)
+                changed = revise(sameOwner, domains) || changed;
+
+            for (const auto& comparison : m_comparisons)
+                changed = revise(comparison, domains) || changed;
+
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < attrTypeCount; ++typeId)
+                changed = reviseBijection(typeId, domains) || changed;
+
+            for (auto typeId = AttributeTypeID{ 0 }; typeId < attrTypeCount; ++typeId)
+            {
+                if (!isConsistent(typeId, domains))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    bool Propagator::revise(const SameOwner& sameOwner, Domains& domains) const
+    {
+        const auto& [first, second, negate] = sameOwner;
+        if (!negate)
+        {
+            // Both values belong to the same person: only the common owners are possible
+            const bool firstChanged = domains.restrict(first.typeId, first.valueId, domains.owners(second.typeId, second.valueId));
+            const bool secondChanged = domains.restrict(second.typeId, second.valueId, domains.owners(first.typeId, first.valueId));
+            return firstChanged || secondChanged;
+        }
+
+        bool changed = false;
+        if (domains.isFixed(first.typeId, first.valueId))
+            changed = domains.restrict(second.typeId, second.valueId, ~domains.owners(first.typeId, first.valueId));
+        if (domains.isFixed(second.typeId, second.valueId))
+            changed = domains.restrict(first.typeId, first.valueId, ~domains.owners(second.typeId, second.valueId)) || changed;
+        return changed;
+    }
+
+    bool Propagator::revise(const PositionComparison& comparison, Domains& domains) const
+    {
+        const auto personCount = domains.personCount();
+        const auto compareBy = comparison.compareByType;
+        const PositionSet allPositions = positionBit(personCount) - 1;
+
+        // Possible positions of each person in the compareBy attribute (a pivoted model: the person index itself)
+        const bool byIdentity = (compareBy == identityAxis);
+        PositionsByPerson positions{};
+        for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ personCount }; ++valueId)
+        {
+            if (byIdentity)
+                positions[valueId.value()] = positionBit(valueId.value());
+            else
+                forEachBit(domains.owners(compareBy, valueId), [&positions, valueId](size_t person) { positions[person] |= positionBit(valueId.value()); });
+        }
+
+        struct Side
+        {
+            PersonSet owners = 0;
+            PositionSet positionFilter = 0; // the value of the compareBy type itself has a known position
+        };
+        auto makeSide = [&domains, compareBy, allPositions](const std::variant<PersonID, Attribute>& comparable) -> Side
+            {
+                if (const auto* personId = std::get_if<PersonID>(&comparable))
+                    return { .owners = Domains::single(*personId), .positionFilter = allPositions };
+
+                const auto& attr = std::get<Attribute>(comparable);
+                const auto filter = (attr.typeId == compareBy) ? positionBit(attr.valueId.value()) : allPositions;
+                return { .owners = domains.owners(attr.typeId, attr.valueId), .positionFilter = filter };
+            };
+        const Side first = makeSide(comparison.first);
+        const Side second = makeSide(comparison.second);
+
+        // For each possible owner of `side`: its positions, for which another possible owner of `partner` has a position satisfying the relation
+        auto supportedPositions = [&positions, allPositions](const Side& side, const Side& partner, Relation relation)
+            {
+                PositionsByPerson supported{};
+                forEachBit(side.owners, [&](size_t person)
+                    {
+                        forEachBit(positions[person] & side.positionFilter, [&](size_t pos)
+                            {
+                                const auto partnerMask = partnerPositions(relation, pos, allPositions);
+                                const auto otherPartners = partner.owners & ~Domains::single(PersonID{ person });
+                                bool found = false;
+                                forEachBit(otherPartners, [&](size_t partnerPerson)
+                                    {
+                                        found = found || (positions[partnerPerson] & partner.positionFilter & partnerMask) != 0;
+                                    });
+                                if (found)
+                                    supported[person] |= positionBit(pos);
+                            });
+                    });
+                return supported;
+            };
+
+        bool changed = false;
+        auto prune = [&](const std::variant<PersonID, Attribute>& comparable, const Side& side, const PositionsByPerson& supported)
+            {
+                PersonSet supportedOwners = 0;
+                forEachBit(side.owners, [&](size_t person) { if (supported[person] != 0) supportedOwners |= Domains::single(PersonID{ person }); });
+
+                if (const auto* attr = std::get_if<Attribute>(&comparable))
+                    changed = domains.restrict(attr->typeId, attr->valueId, supportedOwners) || changed;
+
+                // The owner is known: its unsupported positions are impossible (if none supported - contradiction via empty domains)
+                if (std::has_single_bit(side.owners) && !byIdentity)
+                {
+                    const auto person = static_cast<size_t>(std::countr_zero(side.owners));
+                    const auto unsupported = positions[person] & ~supported[person];
+                    forEachBit(unsupported, [&](size_t pos)
+                        {
+                            changed = domains.remove(compareBy, AttributeValueID{ pos }, PersonID{ person }) || changed;
+                        });
+                }
+            };
+
+        const auto firstSupported = supportedPositions(first, second, comparison.relation);
+        const auto secondSupported = supportedPositions(second, first, reversed(comparison.relation));
+        prune(comparison.first, first, firstSupported);
+        prune(comparison.second, second, secondSupported);
+        return changed;
+    }
+
+    bool Propagator::reviseBijection(AttributeTypeID typeId, Domains& domains) const
+    {
+        const auto personCount = domains.personCount();
+        bool changed = false;
+
+        // A fixed owner can't own other values
+        for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ personCount }; ++valueId)
+        {
+            if (!domains.isFixed(typeId, valueId))
+                continue;
+
+            const auto owner = domains.owners(typeId, valueId);
+            for (auto otherId = AttributeValueID{ 0 }; otherId < AttributeValueID{ personCount }; ++otherId)
+            {
+                if (otherId != valueId)
+                    changed = domains.restrict(typeId, otherId, ~owner) || changed;
+            }
+        }
+
+        // A person possible for the only value owns it
+        for (auto personId = PersonID{ 0 }; personId < PersonID{ personCount }; ++personId)
+        {
+            std::optional<AttributeValueID> onlyValue;
+            size_t possibleCount = 0;
+            for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ personCount } && possibleCount < 2; ++valueId)
+            {
+                if (domains.allows(typeId, valueId, personId))
+                {
+                    onlyValue = valueId;
+                    ++possibleCount;
+                }
+            }
+            if (possibleCount == 1)
+                changed = domains.restrict(typeId, *onlyValue, Domains::single(personId)) || changed;
+        }
+
+        return changed;
+    }
+
+}
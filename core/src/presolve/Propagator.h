@@ -0,0 +1,37 @@
+#pragma once
+#include "PuzzleModel.h"
+#include "Domains.h"
+
+namespace epuzzle::details::presolve
+{
+    // Cheap constraint propagation over person x value domains, runs to a fixpoint:
+    // * unary facts (PersonProperty) - applied once by initialDomains();
+    // * SameOwner chains - both attributes share one domain (or exclude a fixed owner for negation);
+    // * PositionComparison - owners and positions without any support for the relation are removed;
+    // * bijection elimination - a fixed owner is removed from other values, a person possible for one value only is fixed.
+    // Sound: never removes an owner that is possible in some solution. Complete on fully fixed domains: then propagate()
+    // succeeds if and only if the fixed assignment is a solution.
+    class Propagator
+    {
+    public:
+        explicit Propagator(const PuzzleModel&);
+
+        // All-allowed domains with unary facts applied (without propagation)
+        Domains initialDomains() const;
+
+        // Return false if a contradiction is found (the domains admit no solution).
+        bool propagate(Domains&) const;
+
+    private:
+        bool revise(const SameOwner&, Domains&) const;
+        bool revise(const PositionComparison&, Domains&) const;
+        bool reviseBijection(AttributeTypeID, Domains&) const;
+
+    private:
+        const PuzzleModel& m_model;
+        std::vector<PersonProperty> m_unaryFacts;
+        std::vector<SameOwner> m_sameOwners;
+        std::vector<PositionComparison> m_comparisons;
+    };
+
+}
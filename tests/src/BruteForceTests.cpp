@@ -1,5 +1,7 @@
 #include "bruteforce/SearchSpace.h"
 #include "bruteforce/SpaceSplitter.h"
+#include "bruteforce/Validator.h"
+#include "utils/platform/LargePages.h"
 
 namespace epuzzle::tests
 {
@@ -39,4 +41,308 @@ namespace epuzzle::tests
         EXPECT_EQ(iterated, totalSolutionCandidates);
     }
 
+    TEST(BruteForceTests, SkipToKeepsRangeCountExact)
+    {
+        constexpr size_t personCount = 3;
+        constexpr size_t attrCount = 3;
+        std::unique_ptr<SearchSpace> space;
+        ASSERT_NO_THROW(space = SearchSpace::create(personCount, attrCount, {}));
+        ASSERT_TRUE(space);
+        const auto totalSolutionCandidates = space->totalSolutionCandidates(); // 6 * 6 * 6
+
+        // Skip the whole wheel 0 on each candidate: only states of the wheels 1 and 2 are visited.
+        // Chunk size 50 is not aligned to the wheel 0 size: the skip must stop at the chunk end.
+        for (const std::uint64_t chunkSize : { 36u, 50u })
+        {
+            SpaceSplitter splitter{ totalSolutionCandidates, chunkSize };
+            std::uint64_t counted = 0;
+            std::uint64_t visited = 0;
+            std::unique_ptr<SearchSpaceCursor> cursor;
+            while (auto chunk = splitter.nextChunk())
+            {
+                ASSERT_TRUE(cursor = space->createCursor(chunk->offset, chunk->count));
+                do
+                {
+                    ++visited;
+                    counted += 1 + cursor->skipTo(details::AttributeTypeID{ 1 });
+                } while (cursor->moveNext());
+            }
+            EXPECT_EQ(counted, totalSolutionCandidates);
+            if (chunkSize == 36u)
+            {
+                EXPECT_EQ(visited, totalSolutionCandidates / 6);
+            }
+        }
+    }
+
+    TEST(BruteForceTests, MinimalChangeWheelOrderOk)
+    {
+        constexpr size_t personCount = 5;
+        std::unique_ptr<SearchSpace> space;
+        ASSERT_NO_THROW(space = SearchSpace::create(personCount, 1, {}, SearchSpace::WheelOrder::MinimalChange));
+        ASSERT_TRUE(space);
+        const auto& wheel = space->wheel(details::AttributeTypeID{ 0 });
+        ASSERT_EQ(wheel.size(), utils::factorial(personCount));
+
+        std::set<std::vector<size_t>> unique;
+        for (size_t position = 0; position < wheel.size(); ++position)
+        {
+            std::vector<size_t> permutation;
+            std::vector<size_t> changed;
+            for (auto valueId = details::AttributeValueID{ 0 }; valueId < details::AttributeValueID{ personCount }; ++valueId)
+            {
+                permutation.push_back(wheel[position][valueId].value());
+                if (position > 0 && wheel[position][valueId] != wheel[position - 1][valueId])
+                    changed.push_back(valueId.value());
+            }
+            unique.insert(std::move(permutation));
+            if (position > 0) // one adjacent transposition
+            {
+                ASSERT_EQ(changed.size(), 2);
+                EXPECT_EQ(changed[1] - changed[0], 1);
+            }
+        }
+        EXPECT_EQ(unique.size(), wheel.size());
+    }
+
+    TEST(BruteForceTests, PackedCandidateMatchesAssignments)
+    {
+        constexpr size_t personCount = 4;
+        constexpr size_t attrCount = 2;
+        std::unique_ptr<SearchSpace> space;
+        ASSERT_NO_THROW(space = SearchSpace::create(personCount, attrCount, {}));
+        ASSERT_TRUE(space);
+
+        auto cursor = space->createCursor();
+        ASSERT_TRUE(cursor);
+        ASSERT_NE(cursor->packedCandidate(), nullptr);
+        std::uint64_t index = 0; // linear: wheel 0 changes fastest
+        do
+        {
+            const auto* packed = cursor->packedCandidate();
+            auto wheelsState = index++;
+            for (auto typeId = details::AttributeTypeID{ 0 }; typeId < details::AttributeTypeID{ attrCount }; ++typeId)
+            {
+                const auto& wheel = space->wheel(typeId);
+                const auto& assignment = wheel[wheelsState % wheel.size()];
+                wheelsState /= wheel.size();
+                for (auto valueId = details::AttributeValueID{ 0 }; valueId < details::AttributeValueID{ personCount }; ++valueId)
+                {
+                    const auto owner = assignment[valueId];
+                    ASSERT_EQ(cursor->ownerOf(typeId, valueId), owner);
+                    ASSERT_EQ(packedOwner(packed[typeId.value()], valueId), owner);
+                    ASSERT_EQ(packedPosition(packed[typeId.value()], owner), valueId.value());
+                }
+            }
+        } while (cursor->moveNext());
+
+        // Persons count above the packed limit: the generic cursor
+        ASSERT_NO_THROW(space = SearchSpace::create(maxPackedPersons + 1, 1, {}));
+        cursor = space->createCursor();
+        ASSERT_TRUE(cursor);
+        EXPECT_EQ(cursor->packedCandidate(), nullptr);
+    }
+
+    TEST(BruteForceTests, AllowedOwnersGenerateSameWheels)
+    {
+        constexpr size_t personCount = 5;
+        // value 0 - person 2 only, value 1 - not person 0
+        auto allowedOwners = [](details::AttributeTypeID, details::AttributeValueID valueId) -> std::uint64_t
+            {
+                if (valueId.value() == 0)
+                    return 1u << 2;
+                return valueId.value() == 1 ? ~std::uint64_t{ 1 } : ~std::uint64_t{ 0 };
+            };
+        auto allowFilter = [&allowedOwners](details::AttributeTypeID typeId, const details::AttributeAssignment& assignment)
+            {
+                for (auto valueId = details::AttributeValueID{ 0 }; valueId < details::AttributeValueID{ assignment.size() }; ++valueId)
+                {
+                    if (((allowedOwners(typeId, valueId) >> assignment[valueId].value()) & 1) == 0)
+                        return false;
+                }
+                return true;
+            };
+
+        for (const auto order : { SearchSpace::WheelOrder::Lexicographic, SearchSpace::WheelOrder::MinimalChange })
+        {
+            std::unique_ptr<SearchSpace> filtered;
+            std::unique_ptr<SearchSpace> generated;
+            ASSERT_NO_THROW(filtered = SearchSpace::create(personCount, 1, allowFilter, order));
+            ASSERT_NO_THROW(generated = SearchSpace::create(personCount, 1, {}, order, allowedOwners));
+
+            const auto& expected = filtered->wheel(details::AttributeTypeID{ 0 });
+            const auto& actual = generated->wheel(details::AttributeTypeID{ 0 });
+            ASSERT_EQ(actual.size(), 3 * utils::factorial(3));
+            ASSERT_EQ(actual.size(), expected.size());
+            for (size_t position = 0; position < actual.size(); ++position)
+            {
+                EXPECT_TRUE(std::ranges::equal(actual[position], expected[position]));
+            }
+        }
+    }
+
+    TEST(BruteForceTests, ParallelWheelGenerationMatchesSerial)
+    {
+        constexpr size_t personCount = 8; // big enough to be split by the owner of the value 0
+        constexpr size_t attrTypeCount = 3;
+        // Person 1 doesn't own the value 2 of the types 1 and 2
+        auto allowFilter = [](details::AttributeTypeID typeId, const details::AttributeAssignment& assignment)
+            {
+                return typeId.value() == 0 || assignment[details::AttributeValueID{ 2 }] != details::PersonID{ 1 };
+            };
+
+        for (const auto order : { SearchSpace::WheelOrder::Lexicographic, SearchSpace::WheelOrder::MinimalChange })
+        {
+            std::unique_ptr<SearchSpace> serial;
+            std::unique_ptr<SearchSpace> parallel;
+            ASSERT_NO_THROW(serial = SearchSpace::create(personCount, attrTypeCount, allowFilter, order));
+            ASSERT_NO_THROW(parallel = SearchSpace::create(personCount, attrTypeCount, allowFilter, order, {}, 4));
+
+            for (auto typeId = details::AttributeTypeID{ 0 }; typeId < details::AttributeTypeID{ attrTypeCount }; ++typeId)
+            {
+                const auto& expected = serial->wheel(typeId);
+                const auto& actual = parallel->wheel(typeId);
+                ASSERT_EQ(actual.size(), expected.size());
+                for (size_t position = 0; position < actual.size(); ++position)
+                {
+                    EXPECT_TRUE(std::ranges::equal(actual[position], expected[position]));
+                }
+            }
+        }
+    }
+
+    TEST(BruteForceTests, LargePageTablesAreAlignedAndAccounted)
+    {
+        auto& resource = platform::LargePageResource::instance();
+        const auto before = resource.usage();
+        {
+            std::pmr::vector<std::uint64_t> small{ 3, platform::largePages() };
+            std::pmr::vector<std::uint64_t> large{ platform::LargePageResource::largePageSize, platform::largePages() }; // 16 MB
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(small.data()) % platform::LargePageResource::cacheLineSize, 0u);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large.data()) % platform::LargePageResource::largePageSize, 0u);
+            large.back() = 1;
+
+            const auto during = resource.usage();
+            const auto total = [](const platform::LargePageResource::Usage& usage)
+                { return usage.hugeTlbBytes + usage.transparentBytes + usage.regularBytes; };
+            EXPECT_GE(total(during) - total(before), large.size() * sizeof(std::uint64_t));
+        }
+        const auto after = resource.usage();
+        EXPECT_EQ(after.hugeTlbBytes, before.hugeTlbBytes);
+        EXPECT_EQ(after.transparentBytes, before.transparentBytes);
+        EXPECT_EQ(after.regularBytes, before.regularBytes);
+    }
+
+    TEST(BruteForceTests, WheelCacheSharesEqualSpecs)
+    {
+        auto& cache = WheelCache::instance();
+        cache.clear();
+        constexpr size_t personCount = 5;
+        WheelSpec free{ .personCount = personCount, .order = SearchSpace::WheelOrder::Lexicographic,
+            .owners = std::vector<std::uint64_t>(personCount, 0b11111), .ascendingOwners = {} };
+        WheelSpec fixed = free;
+        fixed.owners[0] = 1u << 2; // value 0 - person 2 only
+        fixed.ascendingOwners = { { details::AttributeValueID{ 1 }, details::AttributeValueID{ 2 } } };
+
+        SearchSpace::WheelSpecs specs(3);
+        specs[details::AttributeTypeID{ 0 }] = free;
+        specs[details::AttributeTypeID{ 1 }] = fixed;
+        specs[details::AttributeTypeID{ 2 }] = free;
+        std::unique_ptr<SearchSpace> first;
+        ASSERT_NO_THROW(first = SearchSpace::create(specs));
+        EXPECT_EQ(first->wheelSize(details::AttributeTypeID{ 0 }), utils::factorial(personCount));
+        EXPECT_EQ(first->wheelSize(details::AttributeTypeID{ 1 }), utils::factorial(personCount - 1) / 2);
+        EXPECT_EQ(&first->wheel(details::AttributeTypeID{ 0 }), &first->wheel(details::AttributeTypeID{ 2 }));
+        EXPECT_EQ(cache.stats().misses, 2u);
+        EXPECT_EQ(cache.stats().hits, 1u);
+
+        // Another space (another solver) of the same specs generates nothing
+        const auto second = SearchSpace::create(specs, 4);
+        for (auto typeId = details::AttributeTypeID{ 0 }; typeId < details::AttributeTypeID{ 3 }; ++typeId)
+        {
+            EXPECT_EQ(&second->wheel(typeId), &first->wheel(typeId));
+        }
+        EXPECT_EQ(cache.stats().misses, 2u);
+        EXPECT_EQ(cache.stats().hits, 4u);
+        EXPECT_EQ(cache.stats().wheels, 2u);
+        cache.clear();
+    }
+
+    TEST(BruteForceTests, WheelCacheEvictsLeastRecentlyUsed)
+    {
+        auto& cache = WheelCache::instance();
+        cache.clear();
+        auto spec = [](size_t personCount)
+            {
+                return WheelSpec{ .personCount = personCount, .order = SearchSpace::WheelOrder::Lexicographic,
+                    .owners = std::vector<std::uint64_t>(personCount, ~std::uint64_t{ 0 }), .ascendingOwners = {} };
+            };
+        auto permutations = [](size_t personCount) { return std::vector<details::AttributeAssignment>(3, details::AttributeAssignment(personCount)); };
+        const auto kept = cache.add(spec(4), permutations(4));
+        cache.add(spec(5), permutations(5));
+        cache.add(spec(6), permutations(6));
+        ASSERT_TRUE(cache.find(spec(4))); // the most recently used now
+
+        cache.setCapacity(kept->memoryBytes() + cache.find(spec(6))->memoryBytes());
+        EXPECT_EQ(cache.stats().evictions, 1u);
+        EXPECT_FALSE(cache.find(spec(5)));
+        EXPECT_EQ(cache.find(spec(4)), kept);
+        EXPECT_TRUE(cache.find(spec(6)));
+
+        cache.setCapacity(0); // a dropped wheel lives while used
+        EXPECT_EQ(cache.stats().wheels, 0u);
+        EXPECT_EQ(kept->permutations.size(), 3u);
+        cache.setCapacity(WheelCache::defaultCapacity);
+        cache.clear();
+    }
+
+
+    TEST(BruteForceTests, ChecksReRankedBetweenChunks)
+    {
+        using details::AttributeTypeID;
+        using details::AttributeValueID;
+        constexpr size_t personCount = 4;
+        constexpr size_t attrCount = 2;
+        std::unique_ptr<SearchSpace> space;
+        ASSERT_NO_THROW(space = SearchSpace::create(personCount, attrCount, {}));
+        ASSERT_TRUE(space);
+
+        // One lowest wheel (0): a cheap check never rejecting (the owners of two values of one type always differ)
+        // and a more complex selective one
+        const details::Attribute value0{ AttributeTypeID{ 0 }, AttributeValueID{ 0 } };
+        const details::Attribute value1{ AttributeTypeID{ 0 }, AttributeValueID{ 1 } };
+        const std::vector<details::ConstraintModel> constraints{
+            details::PositionComparison{ value0, value1, AttributeTypeID{ 1 }, PuzzleDefinition::Comparison::Relation::ImmediateLeft },
+            details::SameOwner{ value0, value1, true } };
+        const Validator validator{ attrCount, constraints, false };
+        auto cache = validator.createCache();
+        const std::vector<std::uint32_t> initialOrder{ 0, 1 }; // by complexity: the never rejecting one first
+        ASSERT_EQ(cache.order(), initialOrder);
+
+        // The same results in any order; the order is kept inside a chunk
+        constexpr std::uint64_t chunkSize = 96;
+        SpaceSplitter splitter{ space->totalSolutionCandidates(), chunkSize };
+        std::vector<std::uint64_t> evaluations; // per chunk
+        while (auto chunk = splitter.nextChunk())
+        {
+            if (chunk->offset > 0)
+                validator.rerank(cache);
+            const auto order = cache.order();
+            const auto before = cache.evaluations();
+            auto cursor = space->createCursor(chunk->offset, chunk->count);
+            ASSERT_TRUE(cursor);
+            do
+            {
+                ASSERT_EQ(!validator.failedWheel(*cursor, cache).has_value(), validator.isSolutionValid(*cursor));
+            } while (cursor->moveNext());
+            EXPECT_EQ(cache.order(), order);
+            evaluations.push_back(cache.evaluations() - before);
+        }
+
+        const std::vector<std::uint32_t> selectiveFirst{ 1, 0 };
+        EXPECT_EQ(cache.order(), selectiveFirst);
+        ASSERT_EQ(evaluations.size(), 6u);
+        EXPECT_LT(evaluations.back(), evaluations.front()); // the never rejecting check is mostly not evaluated
+    }
+
 }
@@ -0,0 +1,133 @@
+#include "epuzzle/Exceptions.h"
+#include "epuzzle/Solver.h"
+#include "epuzzle/PuzzleParser.h"
+#include "bruteforce/Checkpoint.h"
+#include "TestUtils.h"
+
+// NOLINTBEGIN(modernize-use-designated-initializers)
+
+namespace epuzzle::tests
+{
+    namespace
+    {
+        using namespace epuzzle::details::bruteforce;
+        using BFConfig = SolverConfig::BruteForceConfig;
+        using Method = SolverConfig::SolvingMethod;
+        using Chunk = SpaceSplitter::Chunk;
+        using test_utils::TempFile;
+
+        std::unique_ptr<Solver> createSolver(std::string_view fileName)
+        {
+            return Solver::create(SolverConfig{ Method::BruteForce, BFConfig{.decompose = false} }, parseFile(test_utils::puzzlePath(fileName)));
+        }
+
+        std::set<std::string> solutionKeys(const std::vector<PuzzleSolution>& solutions)
+        {
+            std::set<std::string> keys;
+            for (const auto& solution : solutions)
+            {
+                std::ostringstream key;
+                key << solution;
+                keys.insert(key.str());
+            }
+            return keys;
+        }
+    }
+
+    TEST(CheckpointTests, SpaceSplitterSkipsDoneRanges)
+    {
+        SpaceSplitter splitter{ 100, 10, { Chunk{ 5, 10 }, Chunk{ 40, 25 }, Chunk{ 95, 5 } } };
+        std::vector<bool> covered(100, false);
+        for (auto range : { std::pair{ 5, 15 }, std::pair{ 40, 65 }, std::pair{ 95, 100 } })
+            std::fill(covered.begin() + range.first, covered.begin() + range.second, true);
+
+        while (const auto chunk = splitter.nextChunk())
+        {
+            ASSERT_GT(chunk->count, 0);
+            ASSERT_LE(chunk->count, 10);
+            for (auto item = chunk->offset; item < chunk->offset + chunk->count; ++item)
+            {
+                ASSERT_FALSE(covered[item]) << item; // neither done nor distributed twice
+                covered[item] = true;
+            }
+        }
+        EXPECT_TRUE(std::ranges::all_of(covered, std::identity{}));
+    }
+
+    TEST(CheckpointTests, StateSavedAndLoaded)
+    {
+        const TempFile file{ "epuzzle_checkpoint_state.txt" };
+        const PuzzleSolution solution{ { { "person", { "Alice", "Bob" } }, { "pet", { "cat", "dog fish" } } } };
+        {
+            Checkpoint checkpoint{ file.path(), 0xabc, 100, {}, std::chrono::milliseconds(1) };
+            checkpoint.commit({ 20, 10 }, {});
+            checkpoint.commit({ 0, 10 }, { solution });
+            checkpoint.commit({ 10, 10 }, {});
+            checkpoint.commit({ 50, 5 }, {});
+        } // the final state is written
+
+        const auto state = Checkpoint::load(file.path(), 0xabc, 100);
+        ASSERT_EQ(state.done.size(), 2); // merged
+        EXPECT_EQ(state.done[0].offset, 0);
+        EXPECT_EQ(state.done[0].count, 30);
+        EXPECT_EQ(state.done[1].offset, 50);
+        EXPECT_EQ(state.doneCount(), 35);
+        ASSERT_EQ(state.solutions.size(), 1);
+        EXPECT_EQ(solutionKeys(state.solutions), solutionKeys({ solution }));
+
+        EXPECT_THROW(Checkpoint::load(file.path(), 0xabd, 100), SolverConfigError);
+        EXPECT_THROW(Checkpoint::load(file.path(), 0xabc, 101), SolverConfigError);
+        EXPECT_TRUE(Checkpoint::load(file.path().string() + ".missing", 0xabc, 100).done.empty());
+    }
+
+    TEST(CheckpointTests, ResumedSearchKeepsSolutions)
+    {
+        const TempFile file{ "epuzzle_checkpoint_resume.txt" };
+        const auto solver = createSolver("four_girls.toml");
+        const auto solutions = solver->solve({ .checkpointFile = file.path() });
+        ASSERT_EQ(solutions.size(), 128);
+        ASSERT_TRUE(std::filesystem::exists(file.path()));
+
+        // All the ranges are done already: no search, the progress starts completed
+        std::uint64_t firstProgress = 0;
+        bool called = false;
+        const auto resumed = createSolver("four_girls.toml")->solve({ .progressCallback = [&](std::uint64_t total, std::uint64_t current)
+            {
+                if (!std::exchange(called, true))
+                    firstProgress = total - current;
+                return true;
+            }, .checkpointFile = file.path(), .resume = true });
+        EXPECT_EQ(firstProgress, 0);
+        EXPECT_EQ(solutionKeys(resumed), solutionKeys(solutions));
+
+        // Another search space
+        EXPECT_THROW(createSolver("einsteins.toml")->solve({ .checkpointFile = file.path(), .resume = true }), SolverConfigError);
+    }
+
+    TEST(CheckpointTests, MergedShardsKeepSolutions)
+    {
+        constexpr size_t shardCount = 4;
+        std::vector<std::unique_ptr<TempFile>> shardFiles;
+        std::vector<std::filesystem::path> shardPaths;
+        std::uint64_t shardSolutions = 0;
+        for (size_t index = 0; index < shardCount; ++index)
+        {
+            const auto& file = shardFiles.emplace_back(std::make_unique<TempFile>("epuzzle_shard" + std::to_string(index) + ".txt"));
+            shardPaths.push_back(file->path());
+            shardSolutions += createSolver("four_girls.toml")->solve({ .checkpointFile = file->path(), .shard = Solver::SolveOptions::Shard{ index, shardCount } }).size();
+        }
+        EXPECT_EQ(shardSolutions, 128);
+
+        const TempFile merged{ "epuzzle_shards_merged.txt" };
+        EXPECT_THROW(mergeShards({ shardPaths.begin(), shardPaths.end() - 1 }, merged.path()), SolverConfigError); // not covered
+        shardPaths.push_back(shardPaths.front()); // duplicates are dropped
+        ASSERT_NO_THROW(mergeShards(shardPaths, merged.path()));
+
+        const auto solutions = createSolver("four_girls.toml")->solve({ .checkpointFile = merged.path(), .resume = true });
+        EXPECT_EQ(solutions.size(), 128);
+        EXPECT_EQ(solutionKeys(solutions), solutionKeys(createSolver("four_girls.toml")->solve({})));
+    }
+
+}
+
+// NOLINTEND(modernize-use-designated-initializers)
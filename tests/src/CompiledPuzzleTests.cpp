@@ -0,0 +1,154 @@
+#include "epuzzle/CompiledPuzzle.h"
+#include "epuzzle/Exceptions.h"
+#include "epuzzle/Solver.h"
+#include "epuzzle/PuzzleParser.h"
+#include "TestUtils.h"
+
+// NOLINTBEGIN(modernize-use-designated-initializers)
+
+namespace epuzzle::tests
+{
+    namespace
+    {
+        using BFConfig = SolverConfig::BruteForceConfig;
+        using Method = SolverConfig::SolvingMethod;
+        using ExecPolicy = SolverConfig::BruteForceConfig::ExecPolicy;
+        using test_utils::TempFile;
+
+        std::set<std::string> solutionKeys(const std::vector<PuzzleSolution>& solutions)
+        {
+            std::set<std::string> keys;
+            for (const auto& solution : solutions)
+            {
+                std::ostringstream key;
+                key << solution;
+                keys.insert(key.str());
+            }
+            return keys;
+        }
+
+        bool hasPrebuiltWheels(const Solver& solver)
+        {
+            return std::ranges::any_of(solver.statistics(), [](const auto& stat) { return stat.first == "Wheels"; });
+        }
+    }
+
+    TEST(CompiledPuzzleTests, SameSolutions)
+    {
+        const std::vector<SolverConfig> configs
+        {
+            SolverConfig{ Method::BruteForce, BFConfig{} },
+            SolverConfig{ Method::BruteForce, BFConfig{ .pivot = false, .execution = ExecPolicy::Sequential } },
+            SolverConfig{ Method::RelationalJoin, BFConfig{}, {}, true }, // probed facts are compiled too
+            SolverConfig{ Method::Counting },
+        };
+        for (const auto* fileName : { "einsteins.toml", "four_girls.toml", "five_ships.toml" })
+        {
+            for (const auto& config : configs)
+            {
+                SCOPED_TRACE(std::string(fileName) + ": " + (std::ostringstream{} << config).str());
+                const TempFile file{ "epuzzle_compiled.epz" };
+                const auto definition = parseFile(test_utils::puzzlePath(fileName));
+                compilePuzzle(config, definition, file.path());
+                ASSERT_TRUE(CompiledPuzzle::isCompiledPuzzle(file.path()));
+
+                const auto compiled = CompiledPuzzle::load(file.path());
+                EXPECT_TRUE(compiled.compiledWith(config));
+                const bool wheelsMethod = config.solvingMethod != Method::Counting;
+                EXPECT_EQ(compiled.hasWheels(), wheelsMethod);
+                auto normalized = definition;
+                normalize(normalized);
+                EXPECT_EQ((std::ostringstream{} << compiled.definition()).str(), (std::ostringstream{} << normalized).str());
+
+                const auto solver = Solver::create(config, compiled);
+                EXPECT_EQ(hasPrebuiltWheels(*solver), wheelsMethod);
+                EXPECT_EQ(solutionKeys(solver->solveSet({}).toVector()), solutionKeys(Solver::create(config, definition)->solveSet({}).toVector()));
+            }
+        }
+    }
+
+    TEST(CompiledPuzzleTests, AnotherConfigStartsFromDefinition)
+    {
+        const TempFile file{ "epuzzle_compiled_config.epz" };
+        compilePuzzle(SolverConfig{ Method::BruteForce, BFConfig{} }, parseFile(test_utils::puzzlePath("einsteins.toml")), file.path());
+        const auto compiled = CompiledPuzzle::load(file.path());
+
+        const SolverConfig another{ Method::BruteForce, BFConfig{ .presolve = false } };
+        EXPECT_FALSE(compiled.compiledWith(another));
+        const auto solver = Solver::create(another, compiled);
+        EXPECT_FALSE(hasPrebuiltWheels(*solver));
+        EXPECT_EQ(solver->solve({}).size(), 1);
+    }
+
+    TEST(CompiledPuzzleTests, BadFileRejected)
+    {
+        EXPECT_FALSE(CompiledPuzzle::isCompiledPuzzle(test_utils::puzzlePath("einsteins.toml")));
+        EXPECT_THROW(CompiledPuzzle::load(test_utils::puzzlePath("einsteins.toml")), PuzzleSyntaxError);
+
+        const TempFile file{ "epuzzle_compiled_bad.epz" };
+        compilePuzzle(SolverConfig{ Method::BruteForce, BFConfig{} }, parseFile(test_utils::puzzlePath("einsteins.toml")), file.path());
+        std::filesystem::resize_file(file.path(), std::filesystem::file_size(file.path()) - 1);
+        EXPECT_TRUE(CompiledPuzzle::isCompiledPuzzle(file.path()));
+        EXPECT_THROW(CompiledPuzzle::load(file.path()), PuzzleSyntaxError);
+    }
+
+    TEST(CompiledPuzzleTests, BadWheelsRejected)
+    {
+        const TempFile file{ "epuzzle_compiled_wheels.epz" };
+        compilePuzzle(SolverConfig{ Method::BruteForce, BFConfig{} }, parseFile(test_utils::puzzlePath("einsteins.toml")), file.path());
+        std::string bytes;
+        {
+            std::ifstream is(file.path(), std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(is), {});
+        }
+        auto loadChanged = [&file, &bytes](auto change)
+            {
+                auto changed = bytes;
+                change(changed);
+                std::ofstream(file.path(), std::ios::binary | std::ios::trunc) << changed;
+                return CompiledPuzzle::load(file.path());
+            };
+        EXPECT_NO_THROW(loadChanged([](std::string&) {}));
+
+        // The wheels are at the end: the last permutation of 5 persons is not a permutation now
+        EXPECT_THROW(loadChanged([](std::string& changed) { std::fill(changed.end() - 5, changed.end(), '\0'); }), PuzzleSyntaxError);
+        EXPECT_THROW(loadChanged([](std::string& changed) { changed[changed.size() - 5] = '\5'; }), PuzzleSyntaxError);
+        // Huge count of the strings: rejected by the file size, not allocated
+        EXPECT_THROW(loadChanged([](std::string& changed)
+            {
+                std::uint32_t configLength = 0;
+                std::memcpy(&configLength, changed.data() + 16, sizeof(configLength)); // after the signature, the version and the byte order mark
+                std::ranges::fill_n(changed.begin() + 20 + configLength, 4, '\xff');
+            }), PuzzleSyntaxError);
+    }
+
+    TEST(CompiledPuzzleTests, BadConfigRejected)
+    {
+        const TempFile file{ "epuzzle_compiled_config_bad.epz" };
+        compilePuzzle(SolverConfig{ Method::BruteForce, BFConfig{} }, parseFile(test_utils::puzzlePath("einsteins.toml")), file.path());
+        std::string bytes;
+        {
+            std::ifstream is(file.path(), std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(is), {});
+        }
+
+        // The stored config is replaced by an invalid one (no BruteForce options): matched, but not trusted
+        const SolverConfig invalid{ Method::BruteForce };
+        const auto invalidText = (std::ostringstream{} << invalid).str();
+        std::uint32_t configLength = 0;
+        std::memcpy(&configLength, bytes.data() + 16, sizeof(configLength)); // after the signature, the version and the byte order mark
+        const auto invalidLength = static_cast<std::uint32_t>(invalidText.size());
+        auto changed = bytes.substr(0, 16);
+        changed.append(reinterpret_cast<const char*>(&invalidLength), sizeof(invalidLength));
+        changed += invalidText;
+        changed += bytes.substr(20 + configLength);
+        std::ofstream(file.path(), std::ios::binary | std::ios::trunc) << changed;
+
+        const auto compiled = CompiledPuzzle::load(file.path());
+        ASSERT_TRUE(compiled.compiledWith(invalid));
+        EXPECT_THROW(Solver::create(invalid, compiled), SolverConfigError);
+    }
+
+}
+
+// NOLINTEND(modernize-use-designated-initializers)
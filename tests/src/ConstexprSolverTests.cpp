@@ -0,0 +1,89 @@
+#include "epuzzle/ConstexprSolver.h"
+#include "epuzzle/Solver.h"
+
+// NOLINTBEGIN(modernize-use-designated-initializers)
+
+namespace epuzzle::tests
+{
+    namespace
+    {
+        using Fact = PuzzleDefinition::Fact;
+        using Comparison = PuzzleDefinition::Comparison;
+        using Relation = PuzzleDefinition::Comparison::Relation;
+
+        constexpr PuzzleDefinition puzzle_3x3(std::vector<std::variant<Fact, Comparison>> constraints)
+        {
+            return PuzzleDefinition
+            {
+                { "NameA", "NameB", "NameC" },
+                {
+                    {{"attr1"}, {"attr1_val1", "attr1_val2", "attr1_val3" }},
+                    {{"attr2"}, {"attr2_val1", "attr2_val2", "attr2_val3" }},
+                    {{"attr3"}, {"attr3_val1", "attr3_val2", "attr3_val3" }}
+                },
+                std::move(constraints)
+            };
+        }
+
+        // attr2 is the order: NameA, NameB, NameC are in a row, attr1_val1 is next to NameC, attr3 is free
+        constexpr PuzzleDefinition orderedPuzzle()
+        {
+            return puzzle_3x3(
+                {
+                    Comparison{ {{"person"}, {"NameA"}}, {{"person"}, {"NameB"}}, "attr2", Relation::ImmediateLeft },
+                    Comparison{ {{"person"}, {"NameB"}}, {{"person"}, {"NameC"}}, "attr2", Relation::ImmediateLeft },
+                    Comparison{ {{"attr1"}, {"attr1_val1"}}, {{"person"}, {"NameC"}}, "attr2", Relation::Adjacent },
+                    Fact{ {{"attr1"}, {"attr1_val2"}}, {{"attr3"}, {"attr3_val3"}} }
+                });
+        }
+
+        // Solved at compile time: no runtime cost
+        constexpr auto orderedSolutions = ct::solve<4>(orderedPuzzle());
+    }
+
+    TEST(ConstexprSolverTests, CountsAtCompileTime)
+    {
+        static_assert(ct::countSolutions(puzzle_3x3({ Fact{ {{"person"}, {"NameA"}}, {{"attr1"}, {"attr1_val1"}} } })) == 2 * 6 * 6);
+        static_assert(ct::countSolutions(puzzle_3x3(
+            {
+                Fact{ {{"person"}, {"NameA"}}, {{"attr1"}, {"attr1_val1"}} },
+                Fact{ {{"person"}, {"NameA"}}, {{"attr1"}, {"attr1_val1"}}, true }
+            })) == 0);
+        static_assert(orderedSolutions.count == 4);
+
+        // The embedded table: attr1_val1 belongs to NameB (NameA, NameB, NameC in a row), attr2 is fixed
+        for (const auto& solution : orderedSolutions.solutions)
+        {
+            EXPECT_EQ(solution.owners[0][0], 1);
+            EXPECT_EQ(solution.owners[1][0], 0);
+            EXPECT_EQ(solution.owners[1][1], 1);
+            EXPECT_EQ(solution.owners[1][2], 2);
+            EXPECT_EQ(solution.owners[0][1], solution.owners[2][2]);
+        }
+    }
+
+    TEST(ConstexprSolverTests, AgreesWithBruteForce)
+    {
+        const std::vector<std::vector<std::variant<Fact, Comparison>>> constraintSets
+        {
+            { Comparison{ {{"attr1"}, {"attr1_val1"}}, {{"attr3"}, {"attr3_val2"}}, "attr2", Relation::Before } },
+            { Comparison{ {{"attr1"}, {"attr1_val1"}}, {{"attr3"}, {"attr3_val2"}}, "attr2", Relation::After } },
+            { Comparison{ {{"person"}, {"NameA"}}, {{"attr3"}, {"attr3_val2"}}, "attr1", Relation::ImmediateRight } },
+            { Comparison{ {{"attr2"}, {"attr2_val3"}}, {{"person"}, {"NameC"}}, "attr3", Relation::Adjacent } },
+            { Fact{ {{"attr1"}, {"attr1_val3"}}, {{"attr2"}, {"attr2_val3"}}, true },
+              Comparison{ {{"attr1"}, {"attr1_val3"}}, {{"attr2"}, {"attr2_val1"}}, "attr1", Relation::ImmediateLeft } },
+        };
+
+        SolverConfig config{ .solvingMethod = SolverConfig::SolvingMethod::BruteForce, .bruteForce = SolverConfig::BruteForceConfig{} };
+        for (const auto& constraints : constraintSets)
+        {
+            const auto puzzle = puzzle_3x3(constraints);
+            std::unique_ptr<Solver> solver;
+            ASSERT_NO_THROW(solver = Solver::create(config, puzzle));
+            EXPECT_EQ(ct::countSolutions(puzzle), solver->countSolutions({}));
+        }
+    }
+
+}
+
+// NOLINTEND(modernize-use-designated-initializers)
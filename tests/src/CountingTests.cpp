@@ -0,0 +1,82 @@
+#include "epuzzle/Solver.h"
+#include "epuzzle/PuzzleParser.h"
+#include "TestUtils.h"
+
+// NOLINTBEGIN(modernize-use-designated-initializers)
+
+namespace epuzzle::tests
+{
+    namespace
+    {
+        using Method = SolverConfig::SolvingMethod;
+        using Fact = PuzzleDefinition::Fact;
+
+        std::unique_ptr<Solver> createCounting(PuzzleDefinition&& puzzle)
+        {
+            std::unique_ptr<Solver> solver;
+            EXPECT_NO_THROW(solver = Solver::create(SolverConfig{ .solvingMethod = Method::Counting }, std::move(puzzle)));
+            return solver;
+        }
+
+        // The only fact "person0 owns attr0_val0": every attribute type is an independent permutation of persons
+        PuzzleDefinition underconstrained(size_t personCount, size_t attrCount)
+        {
+            PuzzleDefinition puzzle;
+            for (size_t person = 0; person < personCount; ++person)
+                puzzle.persons.push_back("person" + std::to_string(person));
+            for (size_t attr = 0; attr < attrCount; ++attr)
+            {
+                PuzzleDefinition::AttributeDescription description{ .type = "attr" + std::to_string(attr), .values = {} };
+                for (size_t value = 0; value < personCount; ++value)
+                    description.values.push_back("attr" + std::to_string(attr) + "_val" + std::to_string(value));
+                puzzle.attributes.push_back(std::move(description));
+            }
+            puzzle.constraints.emplace_back(Fact{ {{"person"}, {"person0"}}, {{"attr0"}, {"attr0_val0"}} });
+            return puzzle;
+        }
+    }
+
+    TEST(CountingTests, FourGirlsCount128)
+    {
+        const auto solver = createCounting(parseFile(test_utils::puzzlePath("four_girls.toml")));
+        ASSERT_TRUE(solver);
+        EXPECT_EQ(solver->countSolutions({}), 128);
+        EXPECT_EQ(solver->solve({}).size(), 128);
+    }
+
+    TEST(CountingTests, EinsteinsCount1)
+    {
+        const auto solver = createCounting(parseFile(test_utils::puzzlePath("einsteins.toml")));
+        ASSERT_TRUE(solver);
+        EXPECT_EQ(solver->countSolutions({}), 1);
+    }
+
+    TEST(CountingTests, UnderconstrainedCountWithoutEnumeration)
+    {
+        // 7! * 8!^3 (~3.3e17) solutions: only counting by components and cache is feasible
+        const auto solver = createCounting(underconstrained(8, 4));
+        ASSERT_TRUE(solver);
+        using namespace utils;
+        EXPECT_EQ(solver->countSolutions({}), factorial(7) * power(factorial(8), 3));
+    }
+
+    TEST(CountingTests, CountEqualsEnumerated)
+    {
+        auto puzzle = underconstrained(3, 3);
+        puzzle.constraints.emplace_back(Fact{ {{"attr0"}, {"attr0_val0"}}, {{"attr1"}, {"attr1_val1"}} });
+        const auto solver = createCounting(std::move(puzzle));
+        ASSERT_TRUE(solver);
+        EXPECT_EQ(solver->countSolutions({}), solver->solve({}).size());
+        EXPECT_EQ(solver->countSolutions({}), 2 * 2 * 6); // attr0_val0 is fixed, attr1_val1 is bound to it
+    }
+
+    TEST(CountingTests, TooManySolutionsThrow)
+    {
+        const auto solver = createCounting(underconstrained(9, 4)); // 8! * 9!^3 > uint64 max
+        ASSERT_TRUE(solver);
+        EXPECT_ANY_THROW(solver->countSolutions({}));
+    }
+
+}
+
+// NOLINTEND(modernize-use-designated-initializers)
@@ -0,0 +1,101 @@
+#include "epuzzle/Solver.h"
+#include "PuzzleModel.h"
+
+// NOLINTBEGIN(modernize-use-designated-initializers)
+
+namespace epuzzle::tests
+{
+    namespace
+    {
+        using namespace epuzzle::details;
+        using BFConfig = SolverConfig::BruteForceConfig;
+        using Method = SolverConfig::SolvingMethod;
+        using ExecPolicy = SolverConfig::BruteForceConfig::ExecPolicy;
+        using Fact = PuzzleDefinition::Fact;
+        using Comparison = PuzzleDefinition::Comparison;
+        using Relation = PuzzleDefinition::Comparison::Relation;
+
+        // attr1 and attr3 are linked, attr2 and attr4 are free
+        PuzzleDefinition puzzle_3x4()
+        {
+            return PuzzleDefinition
+            {
+                { "NameA", "NameB", "NameC" },
+                {
+                    {{"attr1"}, {"attr1_val1", "attr1_val2", "attr1_val3" }},
+                    {{"attr2"}, {"attr2_val1", "attr2_val2", "attr2_val3" }},
+                    {{"attr3"}, {"attr3_val1", "attr3_val2", "attr3_val3" }},
+                    {{"attr4"}, {"attr4_val1", "attr4_val2", "attr4_val3" }}
+                },
+                {
+                    Fact{ {{"person"}, {"NameA"}}, {{"attr1"}, {"attr1_val1"}} },
+                    Comparison{ {{"person"}, {"NameB"}}, {{"attr1"}, {"attr1_val1"}}, "attr3", Relation::ImmediateLeft }
+                }
+            };
+        }
+
+        SolutionSet solveSet(bool decompose)
+        {
+            const auto solver = Solver::create(SolverConfig{ Method::BruteForce, BFConfig{.decompose = decompose, .execution = ExecPolicy::Sequential} }, puzzle_3x4());
+            return solver->solveSet({});
+        }
+    }
+
+    TEST(DecompositionTests, IndependentComponentsFound)
+    {
+        auto definition = puzzle_3x4();
+        normalize(definition);
+        const PuzzleModel model{ std::move(definition) };
+        const auto components = model.independentComponents();
+        ASSERT_EQ(components.size(), 3);
+        EXPECT_EQ(components[0], (std::vector{ AttributeTypeID{ 0 }, AttributeTypeID{ 2 } }));
+        EXPECT_EQ(components[1], (std::vector{ AttributeTypeID{ 1 } }));
+        EXPECT_EQ(components[2], (std::vector{ AttributeTypeID{ 3 } }));
+
+        const auto sub = model.subModel(components[0]);
+        EXPECT_EQ(sub.attrTypeCount(), 2);
+        EXPECT_EQ(sub.attrTypeName(AttributeTypeID{ 1 }), "attr3");
+        EXPECT_EQ(sub.constraints().size(), model.constraints().size());
+    }
+
+    TEST(DecompositionTests, ProductEqualsFullSearch)
+    {
+        const auto decomposed = solveSet(true);
+        const auto whole = solveSet(false);
+        // attr1 x attr3: NameA owns attr1_val1 and NameB is immediately left of NameA by attr3 -> 2 * 2; attr2, attr4 are free: 6 * 6
+        ASSERT_EQ(decomposed.size(), 2 * 2 * 6 * 6);
+        ASSERT_EQ(decomposed.size(), whole.size());
+
+        auto toKey = [](const PuzzleSolution& solution)
+            {
+                std::string key;
+                for (const auto& attr : solution.attributes)
+                {
+                    key += attr.type + ":";
+                    for (const auto& value : attr.values)
+                        key += value + ",";
+                }
+                return key;
+            };
+        std::set<std::string> decomposedKeys;
+        for (std::uint64_t index = 0; index < decomposed.size(); ++index)
+            decomposedKeys.insert(toKey(decomposed[index]));
+
+        std::set<std::string> wholeKeys;
+        for (const auto& solution : whole.toVector())
+            wholeKeys.insert(toKey(solution));
+
+        EXPECT_EQ(decomposedKeys, wholeKeys); // the same solutions, with the same attributes order
+    }
+
+    TEST(DecompositionTests, SolutionSetOutOfRangeThrow)
+    {
+        const SolutionSet set{ { std::vector<PuzzleSolution>(2), std::vector<PuzzleSolution>(3) }, {} };
+        EXPECT_EQ(set.size(), 6);
+        EXPECT_ANY_THROW(set[6]);
+        EXPECT_TRUE(SolutionSet{}.empty());
+    }
+
+}
+
+// NOLINTEND(modernize-use-designated-initializers)
@@ -0,0 +1,49 @@
+#include "epuzzle/Solver.h"
+#include "epuzzle/PuzzleParser.h"
+#include "TestUtils.h"
+
+// NOLINTBEGIN(modernize-use-designated-initializers)
+
+namespace epuzzle::tests
+{
+    namespace
+    {
+        using BFConfig = SolverConfig::BruteForceConfig;
+        using Method = SolverConfig::SolvingMethod;
+
+        std::vector<PuzzleSolution> solve(std::string_view fileName, BFConfig bfConfig)
+        {
+            std::unique_ptr<Solver> solver;
+            std::vector<PuzzleSolution> solutions;
+            EXPECT_NO_THROW(solver = Solver::create(SolverConfig{ Method::RelationalJoin, bfConfig }, parseFile(test_utils::puzzlePath(fileName))));
+            if (solver)
+            {
+                EXPECT_NO_THROW(solutions = solver->solve({}));
+            }
+            return solutions;
+        }
+    }
+
+    TEST(JoinTests, EinsteinsSolutionCount1Correct)
+    {
+        const auto solutions = solve("einsteins.toml", BFConfig{ .presolve = false });
+        ASSERT_EQ(solutions.size(), 1);
+        EXPECT_TRUE(personHasAttribute(solutions.front(), "Норвежец", "beverage", "вода"));
+        EXPECT_TRUE(personHasAttribute(solutions.front(), "Японец", "pet", "зебра"));
+    }
+
+    TEST(JoinTests, FourGirlsSolutionCount128)
+    {
+        EXPECT_EQ(solve("four_girls.toml", BFConfig{}).size(), 128);
+        EXPECT_EQ(solve("four_girls.toml", BFConfig{ .prefilter = false, .presolve = false, .breakSymmetry = false }).size(), 128);
+    }
+
+    TEST(JoinTests, SixHousesSolutionCount528)
+    {
+        // Weeks for the full enumeration, the intermediate results of the join stay small
+        EXPECT_EQ(solve("six_houses.toml", BFConfig{}).size(), 528);
+    }
+
+}
+
+// NOLINTEND(modernize-use-designated-initializers)
@@ -0,0 +1,97 @@
+#include "epuzzle/Solver.h"
+#include "epuzzle/PuzzleParser.h"
+#include "TestUtils.h"
+
+// NOLINTBEGIN(modernize-use-designated-initializers)
+
+namespace epuzzle::tests
+{
+    namespace
+    {
+        using Method = SolverConfig::SolvingMethod;
+        using LSConfig = SolverConfig::LocalSearchConfig;
+        using Fact = PuzzleDefinition::Fact;
+
+        std::vector<PuzzleSolution> solve(PuzzleDefinition&& puzzle, LSConfig lsConfig)
+        {
+            std::unique_ptr<Solver> solver;
+            std::vector<PuzzleSolution> solutions;
+            EXPECT_NO_THROW(solver = Solver::create(SolverConfig{ .solvingMethod = Method::LocalSearch, .localSearch = lsConfig }, std::move(puzzle)));
+            if (solver)
+            {
+                EXPECT_NO_THROW(solutions = solver->solve({}));
+            }
+            return solutions;
+        }
+
+        // Two persons own the same value
+        PuzzleDefinition unsolvable()
+        {
+            return PuzzleDefinition
+            {
+                { "NameA", "NameB" },
+                {
+                    {{"attr1"}, {"attr1_val1", "attr1_val2" }},
+                    {{"attr2"}, {"attr2_val1", "attr2_val2" }}
+                },
+                {
+                    Fact{ {{"person"}, {"NameA"}}, {{"attr1"}, {"attr1_val1"}} },
+                    Fact{ {{"person"}, {"NameB"}}, {{"attr1"}, {"attr1_val1"}} }
+                }
+            };
+        }
+    }
+
+    TEST(LocalSearchTests, EinsteinsSolutionFoundCorrect)
+    {
+        const auto solutions = solve(parseFile(test_utils::puzzlePath("einsteins.toml")), LSConfig{ .seed = 7 });
+        ASSERT_EQ(solutions.size(), 1);
+        EXPECT_TRUE(personHasAttribute(solutions.front(), "Норвежец", "beverage", "вода"));
+        EXPECT_TRUE(personHasAttribute(solutions.front(), "Японец", "pet", "зебра"));
+    }
+
+    TEST(LocalSearchTests, SameSeedSameSolution)
+    {
+        // four_girls.toml has 128 solutions, so different search paths usually give different solutions
+        const auto first = solve(parseFile(test_utils::puzzlePath("four_girls.toml")), LSConfig{ .seed = 42 });
+        const auto second = solve(parseFile(test_utils::puzzlePath("four_girls.toml")), LSConfig{ .seed = 42 });
+        ASSERT_EQ(first.size(), 1);
+        ASSERT_EQ(second.size(), 1);
+        ASSERT_EQ(first.front().attributes.size(), second.front().attributes.size());
+        for (size_t i = 0; i < first.front().attributes.size(); ++i)
+            EXPECT_EQ(first.front().attributes[i].values, second.front().attributes[i].values);
+    }
+
+    TEST(LocalSearchTests, UnsolvableStopsByTimeBudget)
+    {
+        using namespace std::chrono_literals;
+        // The budget is over: reported as the whole progress, without a solution
+        std::uint64_t lastProgress = 0;
+        std::uint64_t progressTotal = 0;
+        const Solver::SolveOptions opts{ .progressCallback = [&](std::uint64_t total, std::uint64_t current)
+            {
+                progressTotal = total;
+                lastProgress = current;
+                return true;
+            } };
+        const auto solver = Solver::create(SolverConfig{ .solvingMethod = Method::LocalSearch, .localSearch = LSConfig{ .timeBudget = 50ms } }, unsolvable());
+        EXPECT_TRUE(solver->solve(opts).empty());
+        EXPECT_EQ(progressTotal, 50u);
+        EXPECT_EQ(lastProgress, progressTotal);
+    }
+
+    TEST(LocalSearchTests, UnsolvableStopsWhenCanceled)
+    {
+        using namespace std::chrono_literals;
+        // Far from the budget: stopped by the progress callback only
+        constexpr size_t cancelAt = 5;
+        size_t calls = 0;
+        const Solver::SolveOptions opts{ .progressInterval = 0ms, .progressCallback = [&calls](auto, auto) { return ++calls < cancelAt; } };
+        const auto solver = Solver::create(SolverConfig{ .solvingMethod = Method::LocalSearch, .localSearch = LSConfig{ .timeBudget = 1h } }, unsolvable());
+        EXPECT_TRUE(solver->solve(opts).empty());
+        EXPECT_EQ(calls, cancelAt);
+    }
+
+}
+
+// NOLINTEND(modernize-use-designated-initializers)
@@ -0,0 +1,100 @@
+#include "epuzzle/Solver.h"
+#include "epuzzle/PuzzleParser.h"
+#include "PuzzleModel.h"
+#include "TestUtils.h"
+
+// NOLINTBEGIN(modernize-use-designated-initializers)
+
+namespace epuzzle::tests
+{
+    namespace
+    {
+        using namespace epuzzle::details;
+        using BFConfig = SolverConfig::BruteForceConfig;
+        using Method = SolverConfig::SolvingMethod;
+        using ExecPolicy = SolverConfig::BruteForceConfig::ExecPolicy;
+        using Fact = PuzzleDefinition::Fact;
+        using Comparison = PuzzleDefinition::Comparison;
+        using Relation = PuzzleDefinition::Comparison::Relation;
+
+        // The fact is about two attributes, so it becomes single-type (prefiltered) when pivoted to attr2.
+        PuzzleDefinition puzzle_3x3()
+        {
+            PuzzleDefinition puzzle
+            {
+                { "NameA", "NameB", "NameC" },
+                {
+                    {{"attr1"}, {"attr1_val1", "attr1_val2", "attr1_val3" }},
+                    {{"attr2"}, {"attr2_val1", "attr2_val2", "attr2_val3" }},
+                    {{"attr3"}, {"attr3_val1", "attr3_val2", "attr3_val3" }}
+                },
+                {
+                    Fact{ {{"attr1"}, {"attr1_val1"}}, {{"attr2"}, {"attr2_val3"}}, false },
+                    Comparison{ {{"person"}, {"NameA"}}, {{"attr3"}, {"attr3_val1"}}, "attr2", Relation::Before }
+                }
+            };
+            normalize(puzzle);
+            return puzzle;
+        }
+
+        std::set<std::string> solutionKeys(const std::vector<PuzzleSolution>& solutions)
+        {
+            std::set<std::string> keys;
+            for (const auto& solution : solutions)
+            {
+                std::string key;
+                for (const auto& attr : solution.attributes)
+                {
+                    key += attr.type + ":";
+                    for (const auto& value : attr.values)
+                        key += value + ",";
+                }
+                keys.insert(std::move(key));
+            }
+            return keys;
+        }
+
+        std::vector<PuzzleSolution> solve(bool pivot, bool breakSymmetry)
+        {
+            const auto solver = Solver::create(SolverConfig{ Method::BruteForce,
+                BFConfig{.decompose = false, .breakSymmetry = breakSymmetry, .pivot = pivot, .execution = ExecPolicy::Sequential} }, puzzle_3x3());
+            return solver->solve({});
+        }
+    }
+
+    TEST(PivotTests, PivotAxisChosen)
+    {
+        const PuzzleModel model{ puzzle_3x3() };
+        EXPECT_EQ(choosePivotAxis(model), AttributeTypeID{ 1 });
+        EXPECT_FALSE(choosePivotAxis(model.pivot(AttributeTypeID{ 1 }))); // pivoted already
+
+        // Its facts are mostly about persons (prefiltered as is), except the cars
+        const PuzzleModel sixHouses{ parseFile(test_utils::puzzlePath("six_houses.toml")) };
+        const auto axis = choosePivotAxis(sixHouses);
+        ASSERT_TRUE(axis);
+        EXPECT_EQ(sixHouses.attrTypeName(*axis), "car");
+        const PuzzleModel einsteins{ parseFile(test_utils::puzzlePath("einsteins.toml")) };
+        EXPECT_FALSE(choosePivotAxis(einsteins));
+    }
+
+    TEST(PivotTests, PivotedSolutionsMatch)
+    {
+        for (const bool breakSymmetry : { false, true })
+        {
+            const auto pivoted = solve(true, breakSymmetry);
+            const auto plain = solve(false, breakSymmetry);
+            ASSERT_FALSE(plain.empty());
+            EXPECT_EQ(pivoted.size(), plain.size());
+            EXPECT_EQ(solutionKeys(pivoted), solutionKeys(plain));
+        }
+    }
+
+    TEST(PivotTests, PivotedSixHousesSolutionCount528)
+    {
+        const auto solver = Solver::create(SolverConfig{ Method::BruteForce, BFConfig{} }, parseFile(test_utils::puzzlePath("six_houses.toml")));
+        EXPECT_EQ(solver->solve({}).size(), 528);
+    }
+
+}
+
+// NOLINTEND(modernize-use-designated-initializers)
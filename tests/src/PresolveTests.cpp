@@ -0,0 +1,139 @@
+#include "epuzzle/Solver.h"
+#include "epuzzle/PuzzleParser.h"
+#include "presolve/Prober.h"
+#include "TestUtils.h"
+
+// NOLINTBEGIN(modernize-use-designated-initializers)
+
+namespace epuzzle::tests
+{
+    namespace
+    {
+        using namespace epuzzle::details;
+        using BFConfig = SolverConfig::BruteForceConfig;
+        using Method = SolverConfig::SolvingMethod;
+        using ExecPolicy = SolverConfig::BruteForceConfig::ExecPolicy;
+        using Fact = PuzzleDefinition::Fact;
+
+        std::uint64_t solutionCandidates(const Solver& solver)
+        {
+            for (const auto& [name, value] : solver.statistics())
+            {
+                if (name == "Solution candidates")
+                    return std::stoull(value);
+            }
+            ADD_FAILURE() << "No solution candidates statistics";
+            return 0;
+        }
+    }
+
+    TEST(PresolveTests, EinsteinsDomainsReduced)
+    {
+        const PuzzleModel model{ parseFile(test_utils::puzzlePath("einsteins.toml")) };
+        const presolve::Propagator propagator{ model };
+        auto domains = propagator.initialDomains();
+        ASSERT_TRUE(propagator.propagate(domains));
+
+        size_t fixedCount = 0;
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ model.attrTypeCount() }; ++typeId)
+        {
+            fixedCount += domains.fixedCount(typeId);
+            EXPECT_LE(domains.allowedCount(typeId), model.personCount() * model.personCount());
+        }
+        EXPECT_GT(fixedCount, 0);
+    }
+
+    TEST(PresolveTests, ContradictionDetected)
+    {
+        const PuzzleModel model
+        {
+            PuzzleDefinition
+            {
+                { "NameA", "NameB" },
+                {
+                    {{"attr1"}, {"attr1_val1", "attr1_val2" }},
+                    {{"attr2"}, {"attr2_val1", "attr2_val2" }}
+                },
+                {
+                    Fact{ {{"person"}, {"NameA"}}, {{"attr1"}, {"attr1_val1"}} },
+                    Fact{ {{"person"}, {"NameB"}}, {{"attr1"}, {"attr1_val1"}} }
+                }
+            }
+        };
+        const presolve::Propagator propagator{ model };
+        auto domains = propagator.initialDomains();
+        EXPECT_FALSE(propagator.propagate(domains));
+    }
+
+    TEST(PresolveTests, SearchSpaceShrinksSolutionsSame)
+    {
+        auto create = [](bool presolve)
+            {
+                return Solver::create(SolverConfig{ Method::BruteForce, BFConfig{.prefilter = true, .presolve = presolve, .execution = ExecPolicy::Sequential} },
+                    parseFile(test_utils::puzzlePath("four_girls.toml")));
+            };
+        const auto plain = create(false);
+        const auto presolved = create(true);
+        EXPECT_LT(solutionCandidates(*presolved), solutionCandidates(*plain));
+        EXPECT_EQ(presolved->solve({}).size(), plain->solve({}).size());
+    }
+
+    TEST(PresolveTests, EinsteinsFewCandidates)
+    {
+        const auto solver = Solver::create(SolverConfig{ Method::BruteForce, BFConfig{.prefilter = true, .presolve = true, .execution = ExecPolicy::Sequential} },
+            parseFile(test_utils::puzzlePath("einsteins.toml")));
+        EXPECT_LT(solutionCandidates(*solver), 1'000'000u);
+        const auto solutions = solver->solve({});
+        ASSERT_EQ(solutions.size(), 1);
+        EXPECT_TRUE(personHasAttribute(solutions.front(), "Норвежец", "beverage", "вода"));
+    }
+
+    TEST(PresolveTests, ProbingSolvesEinsteins)
+    {
+        const PuzzleModel model{ parseFile(test_utils::puzzlePath("einsteins.toml")) };
+        const presolve::Propagator propagator{ model };
+        auto domains = propagator.initialDomains();
+        ASSERT_TRUE(presolve::Prober(propagator, 4).probe(domains));
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ model.attrTypeCount() }; ++typeId)
+            EXPECT_TRUE(domains.isFixed(typeId));
+    }
+
+    TEST(PresolveTests, ProbedFactsAreNewOnly)
+    {
+        PuzzleModel model{ parseFile(test_utils::puzzlePath("einsteins.toml")) };
+        const auto initial = presolve::Propagator{ model }.initialDomains();
+        const auto constraintCount = model.constraints().size();
+        presolve::addProbedFacts(model, 1);
+
+        // Probing fixes every value: one fact per value not fixed by the model facts, no negations
+        size_t notFixed = 0;
+        for (auto typeId = AttributeTypeID{ 0 }; typeId < AttributeTypeID{ model.attrTypeCount() }; ++typeId)
+        {
+            for (auto valueId = AttributeValueID{ 0 }; valueId < AttributeValueID{ model.personCount() }; ++valueId)
+                notFixed += initial.isFixed(typeId, valueId) ? 0 : 1;
+        }
+        ASSERT_EQ(model.constraints().size() - constraintCount, notFixed);
+        for (size_t index = constraintCount; index < model.constraints().size(); ++index)
+        {
+            const auto* fact = std::get_if<PersonProperty>(&model.constraints()[index]);
+            ASSERT_TRUE(fact);
+            EXPECT_FALSE(fact->negate);
+            EXPECT_FALSE(initial.isFixed(fact->attr.typeId, fact->attr.valueId));
+        }
+    }
+
+    TEST(PresolveTests, ProbingKeepsSolutions)
+    {
+        auto solve = [](bool probing)
+            {
+                SolverConfig config{ Method::BruteForce, BFConfig{.prefilter = true, .presolve = true, .execution = ExecPolicy::Sequential} };
+                config.probing = probing;
+                return Solver::create(config, parseFile(test_utils::puzzlePath("four_girls.toml")))->solve({});
+            };
+        EXPECT_EQ(solve(true).size(), 128);
+        EXPECT_EQ(solve(false).size(), 128);
+    }
+
+}
+
+// NOLINTEND(modernize-use-designated-initializers)
@@ -0,0 +1,201 @@
+#include "epuzzle/PuzzleParser.h"
+#include "epuzzle/ResultCache.h"
+#include "epuzzle/Solver.h"
+#include "TestUtils.h"
+
+// NOLINTBEGIN(modernize-use-designated-initializers)
+
+namespace epuzzle::tests
+{
+    namespace
+    {
+        using BFConfig = SolverConfig::BruteForceConfig;
+        using Method = SolverConfig::SolvingMethod;
+        using Relation = PuzzleDefinition::Comparison::Relation;
+
+        std::set<std::string> solutionKeys(const std::vector<PuzzleSolution>& solutions)
+        {
+            std::set<std::string> keys;
+            for (const auto& solution : solutions)
+                keys.insert((std::ostringstream{} << solution).str());
+            return keys;
+        }
+
+        std::string cacheStatistics(const Solver& solver)
+        {
+            const auto stats = solver.statistics();
+            const auto found = std::ranges::find(stats, std::string("Result cache"), [](const auto& stat) { return stat.first; });
+            return found != stats.end() ? found->second : std::string{};
+        }
+
+        // The same puzzle: other labels; the persons, the attributes, the values (but of compared-by types) and the constraints
+        // in reverse order; the comparisons and the facts in their symmetric forms
+        PuzzleDefinition disguise(PuzzleDefinition definition)
+        {
+            auto relabel = [](std::string& name)
+                {
+                    if (name != PuzzleDefinition::personTypeName)
+                        name = "x_" + name;
+                };
+            auto relabelAttr = [&relabel](PuzzleDefinition::Attribute& attr)
+                {
+                    relabel(attr.type);
+                    relabel(attr.value);
+                };
+
+            std::set<std::string> comparedBy;
+            for (auto& constraint : definition.constraints)
+            {
+                if (auto* fact = std::get_if<PuzzleDefinition::Fact>(&constraint))
+                {
+                    std::swap(fact->first, fact->second); // the persons go first again by normalize
+                    relabelAttr(fact->first);
+                    relabelAttr(fact->second);
+                }
+                else if (auto* comparison = std::get_if<PuzzleDefinition::Comparison>(&constraint))
+                {
+                    comparedBy.insert(comparison->compareBy);
+                    std::swap(comparison->first, comparison->second);
+                    switch (comparison->relation)
+                    {
+                    case Relation::ImmediateLeft:   comparison->relation = Relation::ImmediateRight; break;
+                    case Relation::ImmediateRight:  comparison->relation = Relation::ImmediateLeft; break;
+                    case Relation::Before:          comparison->relation = Relation::After; break;
+                    case Relation::After:           comparison->relation = Relation::Before; break;
+                    default: break; // Adjacent
+                    }
+                    relabelAttr(comparison->first);
+                    relabelAttr(comparison->second);
+                    relabel(comparison->compareBy);
+                }
+            }
+            for (auto& attr : definition.attributes)
+            {
+                if (!comparedBy.contains(attr.type))
+                    std::ranges::reverse(attr.values);
+                relabel(attr.type);
+                std::ranges::for_each(attr.values, relabel);
+            }
+            std::ranges::reverse(definition.persons);
+            std::ranges::for_each(definition.persons, relabel);
+            std::ranges::reverse(definition.attributes);
+            std::ranges::reverse(definition.constraints);
+            return definition;
+        }
+    }
+
+    TEST(ResultCacheTests, FingerprintIgnoresLabelsAndOrder)
+    {
+        for (const auto* fileName : { "einsteins.toml", "four_girls.toml", "five_ships.toml", "six_houses.toml" })
+        {
+            SCOPED_TRACE(fileName);
+            const auto definition = parseFile(test_utils::puzzlePath(fileName));
+            const auto expected = fingerprint(definition);
+            EXPECT_EQ(expected.size(), 64u);
+            EXPECT_EQ(fingerprint(disguise(definition)), expected);
+
+            auto another = definition;
+            another.constraints.pop_back();
+            EXPECT_NE(fingerprint(another), expected);
+        }
+    }
+
+    TEST(ResultCacheTests, HitReturnsOwnLabels)
+    {
+        ResultCache cache;
+        for (const auto* fileName : { "einsteins.toml", "four_girls.toml" })
+        {
+            SCOPED_TRACE(fileName);
+            const auto definition = parseFile(test_utils::puzzlePath(fileName));
+            const auto disguised = disguise(definition);
+            const SolverConfig config{ Method::BruteForce, BFConfig{} };
+
+            const auto first = Solver::create(config, definition, cache);
+            EXPECT_TRUE(cacheStatistics(*first).starts_with("miss"));
+            const auto expected = first->solveSet({}).size();
+
+            // Another method of the same result, another form of the puzzle
+            const auto second = Solver::create(SolverConfig{ Method::Counting }, disguised, cache);
+            EXPECT_TRUE(cacheStatistics(*second).starts_with("hit"));
+            EXPECT_EQ(second->countSolutions({}), expected);
+            const auto solutions = second->solve({});
+            EXPECT_EQ(solutions.size(), expected);
+            EXPECT_EQ(solutionKeys(solutions), solutionKeys(Solver::create(config, disguised)->solveSet({}).toVector()));
+        }
+        EXPECT_EQ(cache.stats().misses, 2u);
+        EXPECT_EQ(cache.stats().hits, 4u);
+        EXPECT_EQ(cache.stats().entries, 2u);
+    }
+
+    TEST(ResultCacheTests, SolutionSetHitKeepsProductForm)
+    {
+        // An independent attribute with interchangeable values: two parts and a symmetry group. Six houses: a pivoted set.
+        auto withPets = parseFile(test_utils::puzzlePath("four_girls.toml"));
+        withPets.attributes.push_back({ .type = "pet", .values = { "cat", "dog", "fish", "parrot" } });
+        withPets.constraints.push_back(PuzzleDefinition::Fact{ .first = { PuzzleDefinition::personTypeName, "Anya" }, .second = { "pet", "cat" } });
+        const auto directory = std::filesystem::temp_directory_path() / "epuzzle_result_cache_sets";
+        for (const auto& definition : { withPets, parseFile(test_utils::puzzlePath("six_houses.toml")) })
+        {
+            std::filesystem::remove_all(directory);
+            const SolverConfig config{ Method::BruteForce, BFConfig{} };
+            const auto missed = Solver::create(config, definition, *std::make_unique<ResultCache>(directory))->solveSet({});
+
+            ResultCache cache{ directory }; // from the disk
+            const auto disguised = disguise(definition);
+            const auto solver = Solver::create(config, disguised, cache);
+            ASSERT_TRUE(cacheStatistics(*solver).starts_with("hit"));
+            const auto hit = solver->solveSet({});
+            EXPECT_EQ(hit.size(), missed.size());
+            EXPECT_EQ(hit.classCount(), missed.classCount());
+            EXPECT_EQ(hit.multiplicity(), missed.multiplicity());
+            EXPECT_EQ(hit.parts().size(), missed.parts().size());
+            EXPECT_EQ(hit.symmetry().size(), missed.symmetry().size());
+            EXPECT_EQ(hit.pivot().has_value(), missed.pivot().has_value());
+            // Solved anew by another method: the reversed six houses are long for the brute force
+            EXPECT_EQ(solutionKeys(hit.toVector()), solutionKeys(Solver::create(SolverConfig{ Method::RelationalJoin, BFConfig{} }, disguised)->solve({})));
+            EXPECT_EQ(solver->solve({}).size(), missed.size());
+        }
+        std::filesystem::remove_all(directory);
+    }
+
+    TEST(ResultCacheTests, DiskCacheSharedByInstances)
+    {
+        const auto directory = std::filesystem::temp_directory_path() / "epuzzle_result_cache";
+        std::filesystem::remove_all(directory);
+        const auto definition = parseFile(test_utils::puzzlePath("four_girls.toml"));
+        const SolverConfig config{ Method::Counting };
+        {
+            ResultCache cache{ directory };
+            EXPECT_EQ(Solver::create(config, definition, cache)->countSolutions({}), 128u);
+            const auto counted = Solver::create(config, definition, cache); // the count only: solved again for the solutions
+            EXPECT_TRUE(cacheStatistics(*counted).starts_with("hit"));
+            EXPECT_EQ(counted->solve({}).size(), 128u);
+        }
+        {
+            ResultCache cache{ directory };
+            const auto solver = Solver::create(config, disguise(definition), cache);
+            EXPECT_TRUE(cacheStatistics(*solver).starts_with("hit"));
+            EXPECT_EQ(solver->solve({}).size(), 128u);
+            EXPECT_EQ(cache.stats().hits, 1u);
+            EXPECT_EQ(cache.stats().misses, 0u);
+        }
+        std::filesystem::remove_all(directory);
+    }
+
+    TEST(ResultCacheTests, CanceledSearchNotCached)
+    {
+        ResultCache cache;
+        const auto definition = parseFile(test_utils::puzzlePath("einsteins.toml"));
+        const Solver::SolveOptions canceling{ .progressCallback = [](auto, auto) { return false; } };
+        Solver::create(SolverConfig{ Method::Counting }, definition, cache)->countSolutions(canceling);
+        EXPECT_EQ(cache.stats().entries, 0u);
+
+        // Not exhaustive: not cached
+        Solver::create(SolverConfig{ Method::LocalSearch, {}, SolverConfig::LocalSearchConfig{} }, definition, cache)->solve({});
+        EXPECT_EQ(cache.stats().entries, 0u);
+        EXPECT_EQ(cache.stats().misses, 1u);
+    }
+
+}
+
+// NOLINTEND(modernize-use-designated-initializers)
@@ -61,7 +61,10 @@ namespace epuzzle::tests
     {
         std::unique_ptr<Solver> solver;
         // Use hard puzzle with long compute (weeks)
-        ASSERT_NO_THROW(solver = Solver::create(GetParam(), parseFile(test_utils::puzzlePath("six_houses.toml"))));
+        auto config = GetParam();
+        if (config.bruteForce)
+            config.bruteForce->pivot = false; // pivoted, it is solved in a second
+        ASSERT_NO_THROW(solver = Solver::create(config, parseFile(test_utils::puzzlePath("six_houses.toml"))));
         ASSERT_TRUE(static_cast<bool>(solver));
         using msec = std::chrono::milliseconds;
         const utils::Stopwatch sw;
@@ -84,6 +87,11 @@ namespace epuzzle::tests
         SolverRealPuzzleTests,
         testing::Values(SolverConfig{ Method::BruteForce, BFConfig{.prefilter = true, .execution = ExecPolicy::Parallel} }));
 
+    INSTANTIATE_TEST_SUITE_P(
+        SolverRealPuzzleBruteForceMeetInTheMiddle,
+        SolverRealPuzzleTests,
+        testing::Values(SolverConfig{ Method::BruteForce, BFConfig{.meetInTheMiddle = true, .execution = ExecPolicy::Parallel} }));
+
     INSTANTIATE_TEST_SUITE_P(
         SolverRealPuzzleDeductive,
         SolverRealPuzzleTests,
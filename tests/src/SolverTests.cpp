@@ -554,17 +554,39 @@ namespace epuzzle::tests
     INSTANTIATE_TEST_SUITE_P(
         SolverBruteForceNoPrefilter,
         SolverTests,
-        testing::Values(SolverConfig{ Method::BruteForce, BFConfig{.prefilter = false, .execution = ExecPolicy::Sequential} }));
+        testing::Values(SolverConfig{ Method::BruteForce, BFConfig{.prefilter = false, .presolve = false, .decompose = false, .breakSymmetry = false, .pivot = false,
+            .execution = ExecPolicy::Sequential} }));
 
     INSTANTIATE_TEST_SUITE_P(
         SolverBruteForce,
         SolverTests,
         testing::Values(SolverConfig{ Method::BruteForce, BFConfig{.prefilter = true, .execution = ExecPolicy::Sequential} }));
 
+    INSTANTIATE_TEST_SUITE_P(
+        SolverBruteForceMinimalChange,
+        SolverTests,
+        testing::Values(SolverConfig{ Method::BruteForce, BFConfig{.prefilter = false, .decompose = false, .breakSymmetry = false,
+            .execution = ExecPolicy::Sequential, .wheelOrder = BFConfig::WheelOrder::MinimalChange} }));
+
+    INSTANTIATE_TEST_SUITE_P(
+        SolverBruteForceMeetInTheMiddle,
+        SolverTests,
+        testing::Values(SolverConfig{ Method::BruteForce, BFConfig{.decompose = false, .meetInTheMiddle = true, .execution = ExecPolicy::Sequential} }));
+
     INSTANTIATE_TEST_SUITE_P(
         SolverDeductive,
         SolverTests,
         testing::Values(SolverConfig{ Method::Deductive, {} }));
+
+    INSTANTIATE_TEST_SUITE_P(
+        SolverCounting,
+        SolverTests,
+        testing::Values(SolverConfig{ Method::Counting, {} }));
+
+    INSTANTIATE_TEST_SUITE_P(
+        SolverRelationalJoin,
+        SolverTests,
+        testing::Values(SolverConfig{ Method::RelationalJoin, BFConfig{.prefilter = false, .presolve = false, .breakSymmetry = false} }));
 }
 
 // NOLINTEND(modernize-use-designated-initializers)
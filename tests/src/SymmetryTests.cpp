@@ -0,0 +1,89 @@
+#include "epuzzle/Solver.h"
+#include "PuzzleModel.h"
+
+// NOLINTBEGIN(modernize-use-designated-initializers)
+
+namespace epuzzle::tests
+{
+    namespace
+    {
+        using namespace epuzzle::details;
+        using BFConfig = SolverConfig::BruteForceConfig;
+        using Method = SolverConfig::SolvingMethod;
+        using ExecPolicy = SolverConfig::BruteForceConfig::ExecPolicy;
+        using Fact = PuzzleDefinition::Fact;
+        using Comparison = PuzzleDefinition::Comparison;
+        using Relation = PuzzleDefinition::Comparison::Relation;
+
+        // Interchangeable: attr1 - val2, val3; attr3 - val2, val3. attr2 is used for comparison, so none of its values.
+        PuzzleDefinition puzzle_3x3()
+        {
+            PuzzleDefinition puzzle
+            {
+                { "NameA", "NameB", "NameC" },
+                {
+                    {{"attr1"}, {"attr1_val1", "attr1_val2", "attr1_val3" }},
+                    {{"attr2"}, {"attr2_val1", "attr2_val2", "attr2_val3" }},
+                    {{"attr3"}, {"attr3_val1", "attr3_val2", "attr3_val3" }}
+                },
+                {
+                    Fact{ {{"person"}, {"NameB"}}, {{"attr3"}, {"attr3_val1"}}, true },
+                    Comparison{ {{"person"}, {"NameA"}}, {{"attr1"}, {"attr1_val1"}}, "attr2", Relation::Before }
+                }
+            };
+            normalize(puzzle);
+            return puzzle;
+        }
+
+        std::set<std::string> solutionKeys(const std::vector<PuzzleSolution>& solutions)
+        {
+            std::set<std::string> keys;
+            for (const auto& solution : solutions)
+            {
+                std::string key;
+                for (const auto& attr : solution.attributes)
+                {
+                    key += attr.type + ":";
+                    for (const auto& value : attr.values)
+                        key += value + ",";
+                }
+                keys.insert(std::move(key));
+            }
+            return keys;
+        }
+
+        SolutionSet solveSet(bool breakSymmetry)
+        {
+            const auto solver = Solver::create(SolverConfig{ Method::BruteForce,
+                BFConfig{.decompose = false, .breakSymmetry = breakSymmetry, .execution = ExecPolicy::Sequential} }, puzzle_3x3());
+            return solver->solveSet({});
+        }
+    }
+
+    TEST(SymmetryTests, InterchangeableValuesFound)
+    {
+        const PuzzleModel model{ puzzle_3x3() };
+        const auto groups = interchangeableValues(model);
+        ASSERT_EQ(groups.size(), 2);
+        EXPECT_EQ(groups[0].typeId, AttributeTypeID{ 0 });
+        EXPECT_EQ(groups[0].values, (std::vector{ AttributeValueID{ 1 }, AttributeValueID{ 2 } }));
+        EXPECT_EQ(groups[1].typeId, AttributeTypeID{ 2 });
+        EXPECT_EQ(groups[1].values, (std::vector{ AttributeValueID{ 1 }, AttributeValueID{ 2 } }));
+    }
+
+    TEST(SymmetryTests, ClassesExpandToAllSolutions)
+    {
+        const auto canonical = solveSet(true);
+        const auto full = solveSet(false);
+        EXPECT_EQ(canonical.multiplicity(), 2 * 2);
+        EXPECT_EQ(full.multiplicity(), 1);
+        EXPECT_EQ(canonical.classCount() * canonical.multiplicity(), full.size());
+
+        const auto expanded = canonical.toVector();
+        EXPECT_EQ(solutionKeys(expanded).size(), expanded.size()); // all distinct
+        EXPECT_EQ(solutionKeys(expanded), solutionKeys(full.toVector()));
+    }
+
+}
+
+// NOLINTEND(modernize-use-designated-initializers)
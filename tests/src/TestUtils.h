@@ -3,4 +3,26 @@
 namespace test_utils
 {
     std::string puzzlePath(std::string_view filename);
+
+    // Removed at the end of the test (with the temporary file of the atomic rename)
+    class TempFile
+    {
+    public:
+        explicit TempFile(std::string_view name)
+            : m_path(std::filesystem::temp_directory_path() / name)
+        {
+            std::filesystem::remove(m_path);
+        }
+        ~TempFile()
+        {
+            std::filesystem::remove(m_path);
+            std::filesystem::remove(std::filesystem::path(m_path) += ".tmp");
+        }
+        TempFile(const TempFile&) = delete;
+        TempFile& operator=(const TempFile&) = delete;
+        const std::filesystem::path& path() const { return m_path; }
+
+    private:
+        const std::filesystem::path m_path;
+    };
 }
@@ -1,12 +1,17 @@
 #pragma once
+#include <cstring>
+#include <filesystem>
 #include <format>
+#include <fstream>
 #include <functional>
 #include <limits>
 #include <ranges>
+#include <set>
 #include <string>
 #include <string_view>
 
 #include <gtest/gtest.h>
 
+#include "utils/Concurrency.h"
 #include "utils/Math.h"
 #include "utils/Meta.h"
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <string_view>
 
 namespace utils
 {
@@ -26,6 +27,19 @@ namespace utils
     static_assert(power(2, 5) == 32);
 
 
+    // FNV-1a: stable across runs and platforms (unlike std::hash), for fingerprints stored in files. Chain by passing the previous hash.
+    constexpr std::uint64_t fnv1a(std::string_view bytes, std::uint64_t hash = 14695981039346656037ULL)
+    {
+        for (const char byte : bytes)
+        {
+            hash ^= static_cast<std::uint8_t>(byte);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+    static_assert(fnv1a("a") == 0xaf63dc4c8601ec8cULL);
+
+
     constexpr std::uint64_t operator"" _u64(unsigned long long value)
     {
         return static_cast<std::uint64_t>(value);
@@ -80,13 +80,14 @@ namespace utils
     };
 
 
-    template <typename T>
-    std::vector<T> join(std::vector<std::vector<T>>&& parts)
+    // The joined container gets the allocator of the first part (e.g. std::pmr::vector keeps its memory resource)
+    template <typename TContainer>
+    TContainer join(std::vector<TContainer>&& parts)
     {
         size_t targetSize = 0;
-        std::ranges::for_each(parts, [&targetSize](const std::vector<T>& part) { targetSize += part.size(); });
+        std::ranges::for_each(parts, [&targetSize](const TContainer& part) { targetSize += part.size(); });
 
-        std::vector<T> joined;
+        TContainer joined(parts.empty() ? typename TContainer::allocator_type{} : parts.front().get_allocator());
         joined.reserve(targetSize);
         for (auto& part : parts)
             std::move(part.begin(), part.end(), std::back_inserter(joined));
@@ -31,9 +31,10 @@ namespace utils
             LocalTracker& operator= (LocalTracker&&) = delete;
 
         public:
-            void update() noexcept
+            void update(std::uint64_t count = 1) noexcept
             {
-                if (++m_delta >= m_countInterval) [[unlikely]]
+                m_delta += count;
+                if (m_delta >= m_countInterval) [[unlikely]]
                     store();
             }
 
@@ -102,15 +103,17 @@ namespace utils
         }
 
         // Return false if user canceled (callback returned false)
-        bool update()
+        bool update(std::uint64_t count = 1)
         {
-            if (++m_processed == m_total) [[unlikely]]
+            m_processed += count;
+            if (m_processed == m_total) [[unlikely]]
             {
                 finish();
                 return true;
             }
 
-            if (++m_countSinceCall >= m_minCountInterval) [[unlikely]]
+            m_countSinceCall += count;
+            if (m_countSinceCall >= m_minCountInterval) [[unlikely]]
             {
                 m_countSinceCall = 0;
                 const auto now = std::chrono::steady_clock::now();
@@ -0,0 +1,13 @@
+#pragma once
+#include <filesystem>
+
+namespace platform
+{
+    // Flushes the written contents of the file to the disk (POSIX: fsync, Windows: FlushFileBuffers), so that it survives
+    // a crash or a power loss. Throw std::runtime_error if the file can't be flushed.
+    void syncFile(const std::filesystem::path&);
+
+    // Flushes the entries of the directory (created, renamed files) to the disk. POSIX only: a no-op on other platforms.
+    // Throw std::runtime_error if the directory can't be flushed.
+    void syncDirectory(const std::filesystem::path&);
+}
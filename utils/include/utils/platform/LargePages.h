@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace platform
+{
+    // Memory resource for big randomly accessed tables (search space wheels, result buffers).
+    // All blocks are cache line aligned. Blocks >= largePageSize are mapped on huge pages to reduce TLB misses:
+    // MAP_HUGETLB (needs reserved hugetlbfs pages) or, if the kernel refuses, madvise(MADV_HUGEPAGE) (transparent huge pages).
+    // Fallback (other platforms, THP disabled): the aligned operator new. Process-wide, thread-safe.
+    class LargePageResource final : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr size_t cacheLineSize = 64;
+        static constexpr size_t largePageSize = size_t{ 2 } * 1024 * 1024;
+
+        // Live bytes by backing, and the count of large blocks left on regular pages
+        struct Usage
+        {
+            size_t hugeTlbBytes = 0;
+            size_t transparentBytes = 0;
+            size_t regularBytes = 0;
+            size_t fallbacks = 0;
+        };
+
+        static LargePageResource& instance();
+        Usage usage() const;
+        std::string usageText() const; // for solver statistics
+
+    private:
+        LargePageResource() = default;
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    private:
+        enum class Backing : std::uint8_t
+        {
+            HugeTlb,
+            Transparent,
+            Regular
+        };
+
+        std::atomic<size_t> m_hugeTlbBytes = 0;
+        std::atomic<size_t> m_transparentBytes = 0;
+        std::atomic<size_t> m_regularBytes = 0;
+        std::atomic<size_t> m_fallbacks = 0;
+        std::mutex m_mappedGuard;
+        std::unordered_map<void*, Backing> m_mapped; // large blocks only: a few per solver
+    };
+
+    inline std::pmr::memory_resource* largePages()
+    {
+        return &LargePageResource::instance();
+    }
+}
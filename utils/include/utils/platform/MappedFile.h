@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace platform
+{
+    // Read-only contents of a file. POSIX: mapped to memory (the pages are read on access and shared with the page cache,
+    // nothing is copied at opening). Other platforms: read into a buffer. Throw std::runtime_error if the file can't be read.
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::filesystem::path&);
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        std::span<const std::byte> bytes() const { return m_bytes; }
+
+    private:
+        std::span<const std::byte> m_bytes;
+        std::vector<std::byte> m_buffer; // not mapped
+    };
+}
@@ -0,0 +1,54 @@
+#include "utils/platform/FileSync.h"
+
+#include <stdexcept>
+#include <string>
+
+#ifdef __unix__
+    #include <fcntl.h>
+    #include <unistd.h>
+#elif defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif
+
+namespace platform
+{
+#ifdef __unix__
+    namespace
+    {
+        void syncPath(const std::filesystem::path& path, int flags)
+        {
+            const int fd = ::open(path.c_str(), flags | O_CLOEXEC);
+            if (fd < 0)
+                throw std::runtime_error("Can't open for flushing: " + path.string());
+            const bool synced = ::fsync(fd) == 0;
+            ::close(fd);
+            if (!synced)
+                throw std::runtime_error("Can't flush to disk: " + path.string());
+        }
+    }
+#endif
+
+    void syncFile(const std::filesystem::path& path)
+    {
+#ifdef __unix__
+        syncPath(path, O_RDWR);
+#elif defined(_WIN32)
+        const HANDLE file = ::CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Can't open for flushing: " + path.string());
+        const bool synced = ::FlushFileBuffers(file) != 0;
+        ::CloseHandle(file);
+        if (!synced)
+            throw std::runtime_error("Can't flush to disk: " + path.string());
+#endif
+    }
+
+    void syncDirectory([[maybe_unused]] const std::filesystem::path& path)
+    {
+#ifdef __unix__
+        syncPath(path.empty() ? std::filesystem::path(".") : path, O_RDONLY | O_DIRECTORY);
+#endif
+    }
+}
@@ -0,0 +1,144 @@
+#include "utils/platform/LargePages.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#ifdef __linux__
+    #include <sys/mman.h>
+#endif
+
+namespace platform
+{
+namespace
+{
+    size_t roundUp(size_t bytes, size_t alignment)
+    {
+        return (bytes + alignment - 1) / alignment * alignment;
+    }
+
+    std::string byteSize(size_t bytes)
+    {
+        constexpr size_t kilobyte = 1024;
+        if (bytes < kilobyte * kilobyte)
+            return std::to_string((bytes + kilobyte - 1) / kilobyte) + " KB";
+        return std::to_string((bytes + kilobyte * kilobyte / 2) / (kilobyte * kilobyte)) + " MB";
+    }
+
+#ifdef __linux__
+    // Anonymous mapping aligned to largePageSize (THP can back only aligned 2 MB ranges): the excess is unmapped
+    void* mapAligned(size_t bytes)
+    {
+        constexpr auto pageSize = LargePageResource::largePageSize;
+        void* raw = ::mmap(nullptr, bytes + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+            return nullptr;
+
+        auto* begin = static_cast<std::byte*>(raw);
+        auto* aligned = begin + (roundUp(reinterpret_cast<std::uintptr_t>(begin), pageSize) - reinterpret_cast<std::uintptr_t>(begin));
+        if (aligned != begin)
+            ::munmap(begin, static_cast<size_t>(aligned - begin));
+        if (const auto tail = static_cast<size_t>(begin + bytes + pageSize - (aligned + bytes)); tail > 0)
+            ::munmap(aligned + bytes, tail);
+        return aligned;
+    }
+#endif
+
+} // namespace
+
+    LargePageResource& LargePageResource::instance()
+    {
+        static LargePageResource resource;
+        return resource;
+    }
+
+    LargePageResource::Usage LargePageResource::usage() const
+    {
+        return { .hugeTlbBytes = m_hugeTlbBytes.load(), .transparentBytes = m_transparentBytes.load(),
+            .regularBytes = m_regularBytes.load(), .fallbacks = m_fallbacks.load() };
+    }
+
+    std::string LargePageResource::usageText() const
+    {
+        const auto current = usage();
+        std::string text = byteSize(current.hugeTlbBytes) + " hugetlb, " + byteSize(current.transparentBytes) + " transparent huge pages, "
+            + byteSize(current.regularBytes) + " regular pages";
+        if (current.fallbacks > 0)
+            text += " (" + std::to_string(current.fallbacks) + " large blocks fell back to regular pages)";
+        return text;
+    }
+
+    void* LargePageResource::do_allocate(size_t bytes, size_t alignment)
+    {
+        alignment = std::max(alignment, cacheLineSize);
+        if (bytes >= largePageSize && alignment <= largePageSize)
+        {
+            bytes = roundUp(bytes, largePageSize);
+            void* ptr = nullptr;
+            auto backing = Backing::Regular;
+#ifdef __linux__
+            ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (ptr != MAP_FAILED)
+            {
+                backing = Backing::HugeTlb;
+            }
+            else
+            {
+                ptr = mapAligned(bytes);
+                if (ptr == nullptr)
+                    throw std::bad_alloc();
+                if (::madvise(ptr, bytes, MADV_HUGEPAGE) == 0)
+                    backing = Backing::Transparent;
+            }
+#else
+            ptr = ::operator new(bytes, std::align_val_t{ alignment });
+#endif
+            {
+                const std::lock_guard lock{ m_mappedGuard };
+                m_mapped.emplace(ptr, backing);
+            }
+            switch (backing)
+            {
+            case Backing::HugeTlb:      m_hugeTlbBytes += bytes; break;
+            case Backing::Transparent:  m_transparentBytes += bytes; break;
+            case Backing::Regular:      m_regularBytes += bytes; ++m_fallbacks; break;
+            }
+            return ptr;
+        }
+
+        void* ptr = ::operator new(bytes, std::align_val_t{ alignment });
+        m_regularBytes += bytes;
+        return ptr;
+    }
+
+    void LargePageResource::do_deallocate(void* ptr, size_t bytes, size_t alignment)
+    {
+        alignment = std::max(alignment, cacheLineSize);
+        if (bytes >= largePageSize && alignment <= largePageSize)
+        {
+            bytes = roundUp(bytes, largePageSize);
+            Backing backing = Backing::Regular;
+            {
+                const std::lock_guard lock{ m_mappedGuard };
+                const auto found = m_mapped.find(ptr);
+                backing = found->second;
+                m_mapped.erase(found);
+            }
+            switch (backing)
+            {
+            case Backing::HugeTlb:      m_hugeTlbBytes -= bytes; break;
+            case Backing::Transparent:  m_transparentBytes -= bytes; break;
+            case Backing::Regular:      m_regularBytes -= bytes; break;
+            }
+#ifdef __linux__
+            ::munmap(ptr, bytes);
+#else
+            ::operator delete(ptr, std::align_val_t{ alignment });
+#endif
+            return;
+        }
+
+        ::operator delete(ptr, std::align_val_t{ alignment });
+        m_regularBytes -= bytes;
+    }
+}
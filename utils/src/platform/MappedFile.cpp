@@ -0,0 +1,52 @@
+#include "utils/platform/MappedFile.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#ifdef __unix__
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace platform
+{
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+#ifdef __unix__
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::runtime_error("Can't open file: " + path.string());
+        struct stat info{};
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("Can't read file: " + path.string());
+        }
+        const auto size = static_cast<size_t>(info.st_size);
+        void* mapped = (size > 0) ? ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+        ::close(fd); // the mapping keeps the file
+        if (mapped == MAP_FAILED)
+            throw std::runtime_error("Can't map file: " + path.string());
+        m_bytes = { static_cast<const std::byte*>(mapped), size };
+#else
+        std::ifstream is(path, std::ios::binary);
+        if (!is)
+            throw std::runtime_error("Can't open file: " + path.string());
+        m_buffer.resize(static_cast<size_t>(std::filesystem::file_size(path)));
+        if (!is.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size())))
+            throw std::runtime_error("Can't read file: " + path.string());
+        m_bytes = m_buffer;
+#endif
+    }
+
+    MappedFile::~MappedFile()
+    {
+#ifdef __unix__
+        if (!m_bytes.empty())
+            ::munmap(const_cast<std::byte*>(m_bytes.data()), m_bytes.size());
+#endif
+    }
+}